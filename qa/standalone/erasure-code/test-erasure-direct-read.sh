@@ -0,0 +1,120 @@
+#!/usr/bin/env bash
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU Library Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Library Public License for more details.
+#
+
+source $CEPH_ROOT/qa/standalone/ceph-helpers.sh
+
+function run() {
+    local dir=$1
+    shift
+
+    export CEPH_MON="127.0.0.1:7311" # git grep '\<7311\>' : there must be only one
+    export CEPH_ARGS
+    CEPH_ARGS+="--fsid=$(uuidgen) --auth-supported=none "
+    CEPH_ARGS+="--mon-host=$CEPH_MON "
+
+    local funcs=${@:-$(set | sed -n -e 's/^\(TEST_[0-9a-z_]*\) .*/\1/p')}
+    for func in $funcs ; do
+        setup $dir || return 1
+        run_mon $dir a || return 1
+        run_mgr $dir x || return 1
+        for id in $(seq 0 2) ; do
+            run_osd $dir $id --osd_ec_direct_chunk_reads=true \
+                --debug_osd=20 || return 1
+        done
+        create_ec_pool || return 1
+        $func $dir || return 1
+        teardown $dir || return 1
+    done
+}
+
+# k=2 m=1 with 4k chunks: each 8k stripe is chunk 0 then chunk 1
+function create_ec_pool() {
+    ceph osd erasure-code-profile set myprofile \
+        plugin=jerasure k=2 m=1 stripe_unit=4096 \
+        crush-failure-domain=osd || return 1
+    create_pool ecpool 1 1 erasure myprofile || return 1
+    ceph osd pool set ecpool allow_ec_overwrites true || return 1
+    wait_for_clean || return 1
+}
+
+function count_direct_reads() {
+    local dir=$1
+    cat $dir/osd.*.log | grep -c 'objects_read_async: direct read of chunk'
+}
+
+# read obj back in op_size pieces and compare with what was written
+function check_read() {
+    local dir=$1
+    local op_size=$2
+
+    rados -p ecpool get obj $dir/out -b $op_size || return 1
+    cmp $dir/in $dir/out || return 1
+}
+
+function TEST_direct_read() {
+    local dir=$1
+
+    dd if=/dev/urandom of=$dir/in bs=4096 count=8 || return 1
+    rados -p ecpool put obj $dir/in || return 1
+
+    # every 4k read lies inside one chunk
+    local before=$(count_direct_reads $dir)
+    check_read $dir 4096 || return 1
+    test $(count_direct_reads $dir) -gt $before || return 1
+
+    # reads that straddle chunks are decoded from the full stripe
+    before=$(count_direct_reads $dir)
+    check_read $dir 8192 || return 1
+    test $(count_direct_reads $dir) -eq $before || return 1
+}
+
+function TEST_direct_read_unaligned() {
+    local dir=$1
+
+    dd if=/dev/urandom of=$dir/in bs=1000 count=33 || return 1
+    rados -p ecpool put obj $dir/in || return 1
+
+    # 3000 byte reads: some fit inside a chunk at an unaligned offset,
+    # others straddle two chunks; the last one is short
+    local before=$(count_direct_reads $dir)
+    check_read $dir 3000 || return 1
+    test $(count_direct_reads $dir) -gt $before || return 1
+}
+
+function TEST_direct_read_shard_missing() {
+    local dir=$1
+
+    dd if=/dev/urandom of=$dir/in bs=4096 count=8 || return 1
+    rados -p ecpool put obj $dir/in || return 1
+
+    # take down the osd holding data chunk 1 (shard 1) and keep the pg
+    # active without it, so that direct reads of that chunk fall back to
+    # decoding from the other shards
+    ceph osd pool set ecpool min_size 2 || return 1
+    ceph osd set noout || return 1
+    local osd=$(get_osds ecpool obj | awk '{print $2}')
+    kill_daemons $dir TERM osd.$osd || return 1
+    ceph osd down $osd || return 1
+    wait_for_osd down $osd || return 1
+
+    timeout 60 rados -p ecpool get obj $dir/out -b 4096 || return 1
+    cmp $dir/in $dir/out || return 1
+    timeout 60 rados -p ecpool get obj $dir/out -b 3000 || return 1
+    cmp $dir/in $dir/out || return 1
+}
+
+main test-erasure-direct-read "$@"
+
+# Local Variables:
+# compile-command: "cd ../../../build ; make -j4 && ../qa/run-standalone.sh test-erasure-direct-read.sh"
+# End:
@@ -0,0 +1,94 @@
+#!/usr/bin/env bash
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU Library Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Library Public License for more details.
+#
+
+source $CEPH_ROOT/qa/standalone/ceph-helpers.sh
+
+function run() {
+    local dir=$1
+    shift
+
+    export CEPH_MON="127.0.0.1:7312" # git grep '\<7312\>' : there must be only one
+    export CEPH_ARGS
+    CEPH_ARGS+="--fsid=$(uuidgen) --auth-supported=none "
+    CEPH_ARGS+="--mon-host=$CEPH_MON --osd_max_backfills=1 "
+    CEPH_ARGS+="--osd_mclock_override_recovery_settings=true "
+    CEPH_ARGS+="--osd_recovery_max_active=2 "
+    CEPH_ARGS+="--osd_backfill_small_object_size=16384 "
+    CEPH_ARGS+="--osd_backfill_small_objects_per_op=4 "
+    CEPH_ARGS+="--debug_osd=20 "
+
+    local funcs=${@:-$(set | sed -n -e 's/^\(TEST_[0-9a-z_]*\) .*/\1/p')}
+    for func in $funcs ; do
+        setup $dir || return 1
+        $func $dir || return 1
+        teardown $dir || return 1
+    done
+}
+
+function TEST_backfill_small_objects() {
+    local dir=$1
+    local OSDS=6
+    local objects=200
+
+    run_mon $dir a || return 1
+    run_mgr $dir x || return 1
+    for osd in $(seq 0 $(expr $OSDS - 1)) ; do
+        run_osd $dir $osd || return 1
+    done
+    create_pool test 1 1 || return 1
+    wait_for_clean || return 1
+
+    dd if=/dev/urandom of=$dir/small bs=1024 count=4 || return 1
+    dd if=/dev/urandom of=$dir/large bs=1024 count=64 || return 1
+    for j in $(seq 1 $objects) ; do
+        rados -p test put obj-${j} $dir/small || return 1
+    done
+    for j in $(seq 1 10) ; do
+        rados -p test put large-${j} $dir/large || return 1
+        rados -p test put omap-${j} $dir/small || return 1
+        rados -p test setomapval omap-${j} key val-${j} || return 1
+    done
+
+    # backfill everything onto a new up set
+    ceph osd out $(ceph pg dump pgs --format=json | jq '.pg_stats[0].up[]') || return 1
+    sleep 1
+    wait_for_clean || return 1
+
+    # small objects did share recovery slots, objects with omap never did
+    grep -q "obj-.* (sharing a recovery slot)" $dir/osd.*.log || return 1
+    ! grep -q "omap-.* (sharing a recovery slot)" $dir/osd.*.log || return 1
+    ! grep -q "large-.* (sharing a recovery slot)" $dir/osd.*.log || return 1
+
+    # the osd-wide count never went past osd_recovery_max_active
+    sed -n -e 's/.*start_recovery_op .* (\([0-9]*\)\/\([0-9]*\) rops)$/\1 \2/p' \
+        $dir/osd.*.log > $dir/rops || return 1
+    test -s $dir/rops || return 1
+    awk '$1 >= $2 { exit 1 }' $dir/rops || return 1
+
+    # and everything arrived intact
+    for j in $(seq 1 $objects) ; do
+        rados -p test get obj-${j} $dir/out || return 1
+        cmp $dir/small $dir/out || return 1
+    done
+    for j in $(seq 1 10) ; do
+        rados -p test get large-${j} $dir/out || return 1
+        cmp $dir/large $dir/out || return 1
+        test "$(rados -p test getomapval omap-${j} key | tail -n +2)" != "" || return 1
+    done
+}
+
+main osd-backfill-small-objects "$@"
+
+# Local Variables:
+# compile-command: "cd ../../../build ; make -j4 && ../qa/run-standalone.sh osd-backfill-small-objects.sh"
+# End:
@@ -0,0 +1,112 @@
+#!/usr/bin/env bash
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU Library Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Library Public License for more details.
+#
+
+source $CEPH_ROOT/qa/standalone/ceph-helpers.sh
+
+function run() {
+    local dir=$1
+    shift
+
+    export CEPH_MON="127.0.0.1:7313" # git grep '\<7313\>' : there must be only one
+    export CEPH_ARGS
+    CEPH_ARGS+="--fsid=$(uuidgen) --auth-supported=none "
+    CEPH_ARGS+="--mon-host=$CEPH_MON "
+
+    local funcs=${@:-$(set | sed -n -e 's/^\(TEST_[0-9a-z_]*\) .*/\1/p')}
+    for func in $funcs ; do
+        setup $dir || return 1
+        $func $dir || return 1
+        teardown $dir || return 1
+    done
+}
+
+function slow_osd() {
+    local id=$1
+    local probability=$2
+
+    ceph tell osd.$id config set \
+        osd_debug_inject_dispatch_delay_duration 0.2 || return 1
+    ceph tell osd.$id config set \
+        osd_debug_inject_dispatch_delay_probability $probability || return 1
+}
+
+function TEST_hedge_reads_slow_primary() {
+    local dir=$1
+
+    run_mon $dir a --osd_pool_default_size=3 || return 1
+    run_mgr $dir x || return 1
+    for id in $(seq 0 2) ; do
+        run_osd $dir $id || return 1
+    done
+    create_pool test 8 8 || return 1
+    wait_for_clean || return 1
+
+    # written one at a time, so that in every pg only the last object
+    # written is too recent for a replica to serve
+    rados -p test bench 60 write -b 4096 -t 1 --max-objects 64 \
+        --no-cleanup || return 1
+
+    # let the client learn osd.0's read latency, then slow osd.0 down
+    (sleep 10 && slow_osd 0 1) &
+    local slow_pid=$!
+    rados -p test bench 25 rand -t 16 \
+        --objecter_hedge_reads=true --debug_objecter=20 \
+        --log-file=$dir/client.log > $dir/bench.out 2>&1
+    local ret=$?
+    wait $slow_pid
+    slow_osd 0 0 || return 1
+    cat $dir/bench.out
+    test $ret = 0 || return 1
+
+    # every read returned the object's data
+    ! grep -q "is not correct" $dir/bench.out || return 1
+    # slow reads were also sent to a replica ...
+    grep -q "_hedge_read [0-9]* slow on osd\.0, also reading from osd\." \
+        $dir/client.log || return 1
+    # ... whose reply completed the op through the primary's session,
+    grep -q "hedged read [0-9]* answered by osd\." $dir/client.log || return 1
+    # the primary's late reply to the same attempt was dropped,
+    grep -q "handle_osd_op_reply [0-9]* .* stray" $dir/client.log || return 1
+    # a replica refused an object with a write it can't yet serve,
+    grep -q "hedged read [0-9]* refused by replica, r=-11" \
+        $dir/client.log || return 1
+    # and no hedge outlived its op
+    grep "_forget_hedge" $dir/client.log | tail -1 | \
+        grep -q " 0 hedged reads left" || return 1
+}
+
+function TEST_hedge_reads_disabled() {
+    local dir=$1
+
+    run_mon $dir a --osd_pool_default_size=3 || return 1
+    run_mgr $dir x || return 1
+    for id in $(seq 0 2) ; do
+        run_osd $dir $id || return 1
+    done
+    create_pool test 8 8 || return 1
+    wait_for_clean || return 1
+
+    rados -p test bench 60 write -b 4096 -t 1 --max-objects 64 \
+        --no-cleanup || return 1
+    slow_osd 0 1 || return 1
+    rados -p test bench 10 rand -t 16 --debug_objecter=20 \
+        --log-file=$dir/client.log || return 1
+    slow_osd 0 0 || return 1
+    ! grep -q "_hedge_read" $dir/client.log || return 1
+}
+
+main osd-hedge-reads "$@"
+
+# Local Variables:
+# compile-command: "cd ../../../build ; make -j4 && ../qa/run-standalone.sh osd-hedge-reads.sh"
+# End:
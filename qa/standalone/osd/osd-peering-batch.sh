@@ -0,0 +1,76 @@
+#!/usr/bin/env bash
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU Library Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Library Public License for more details.
+#
+
+source $CEPH_ROOT/qa/standalone/ceph-helpers.sh
+
+function run() {
+    local dir=$1
+    shift
+
+    export CEPH_MON="127.0.0.1:7310" # git grep '\<7310\>' : there must be only one
+    export CEPH_ARGS
+    CEPH_ARGS+="--fsid=$(uuidgen) --auth-supported=none "
+    CEPH_ARGS+="--mon-host=$CEPH_MON "
+
+    local funcs=${@:-$(set | sed -n -e 's/^\(TEST_[0-9a-z_]*\) .*/\1/p')}
+    for func in $funcs ; do
+        setup $dir || return 1
+        $func $dir || return 1
+        teardown $dir || return 1
+    done
+}
+
+function peer_after_restart() {
+    local dir=$1
+    shift
+    local batch_max=$1
+
+    run_mon $dir a --osd_pool_default_size=3 || return 1
+    run_mgr $dir x || return 1
+    for id in $(seq 0 2) ; do
+        run_osd $dir $id --osd_peering_batch_max=$batch_max \
+            --debug_osd=20 || return 1
+    done
+    create_pool test 64 64 || return 1
+    wait_for_clean || return 1
+    rados -p test bench 5 write -b 4096 --no-cleanup || return 1
+
+    # every pg on osd.0 peers with the other two at once
+    kill_daemons $dir TERM osd.0 || return 1
+    ceph osd down 0 || return 1
+    activate_osd $dir 0 --osd_peering_batch_max=$batch_max \
+        --debug_osd=20 || return 1
+    wait_for_clean || return 1
+}
+
+function TEST_peering_batch() {
+    local dir=$1
+
+    peer_after_restart $dir 16 || return 1
+    # notifies and infos were actually coalesced
+    grep -q "_send_peering_batch osd\.[0-9]* [0-9]* entries in" \
+        $dir/osd.*.log || return 1
+}
+
+function TEST_peering_batch_disabled() {
+    local dir=$1
+
+    peer_after_restart $dir 0 || return 1
+    ! grep -q "_send_peering_batch" $dir/osd.*.log || return 1
+}
+
+main osd-peering-batch "$@"
+
+# Local Variables:
+# compile-command: "cd ../../../build ; make -j4 && ../qa/run-standalone.sh osd-peering-batch.sh"
+# End:
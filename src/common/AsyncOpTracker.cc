@@ -14,11 +14,20 @@ AsyncOpTracker::~AsyncOpTracker() {
 }
 
 void AsyncOpTracker::start_op() {
-  std::lock_guard locker(m_lock);
-  ++m_pending_ops;
+  m_pending_ops.fetch_add(1, std::memory_order_relaxed);
 }
 
 void AsyncOpTracker::finish_op() {
+  // the counter may only reach zero under m_lock so that a waiter cannot
+  // observe it (and destroy the tracker) while we are still using it
+  auto pending = m_pending_ops.load(std::memory_order_relaxed);
+  while (pending > 1) {
+    if (m_pending_ops.compare_exchange_weak(pending, pending - 1,
+                                            std::memory_order_acq_rel)) {
+      return;
+    }
+  }
+
   Context *on_finish = nullptr;
   {
     std::lock_guard locker(m_lock);
@@ -46,7 +55,6 @@ void AsyncOpTracker::wait_for_ops(Context *on_finish) {
 }
 
 bool AsyncOpTracker::empty() {
-  std::lock_guard locker(m_lock);
   return (m_pending_ops == 0);
 }
 
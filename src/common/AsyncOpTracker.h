@@ -4,6 +4,8 @@
 #ifndef CEPH_ASYNC_OP_TRACKER_H
 #define CEPH_ASYNC_OP_TRACKER_H
 
+#include <atomic>
+
 #include "common/ceph_mutex.h"
 #include "include/Context.h"
 
@@ -20,8 +22,11 @@ public:
   bool empty();
 
 private:
+  // m_pending_ops only reaches zero under m_lock, so wait_for_ops sees
+  // either a pending op or a finished count. finish_op therefore only
+  // takes m_lock for what may be the last pending op.
   ceph::mutex m_lock = ceph::make_mutex("AsyncOpTracker::m_lock");
-  uint32_t m_pending_ops = 0;
+  std::atomic<uint32_t> m_pending_ops = {0};
   Context *m_on_finish = nullptr;
 
 };
@@ -17,6 +17,9 @@
 
 #include <memory>
 
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/recycling_allocator.hpp>
+
 #include "bind_handler.h"
 #include "forward_handler.h"
 
@@ -33,6 +36,10 @@ namespace ceph::async {
  * this, the static functions defer()/dispatch()/post() take the completion by
  * rvalue-reference to std::unique_ptr<Completion>, i.e. std::move(completion).
  *
+ * Handlers without an associated allocator (plain lambdas, coroutine
+ * handlers) use boost::asio::recycling_allocator, which keeps freed blocks in
+ * a per-thread cache instead of returning them to the heap.
+ *
  * Handlers may also have an 'associated executor', so the calls to defer(),
  * dispatch(), and post() are forwarded to that executor. If there is no
  * associated executor (which is generally the case unless one was bound with
@@ -166,8 +173,9 @@ class CompletionImpl final : public Completion<void(Args...), T> {
   std::pair<Work1, Work2> work;
   Handler handler;
 
-  // use Handler's associated allocator
-  using Alloc2 = boost::asio::associated_allocator_t<Handler>;
+  // use Handler's associated allocator, or recycle memory per thread
+  using DefaultAlloc = boost::asio::recycling_allocator<void>;
+  using Alloc2 = boost::asio::associated_allocator_t<Handler, DefaultAlloc>;
   using Traits2 = std::allocator_traits<Alloc2>;
   using RebindAlloc2 = typename Traits2::template rebind_alloc<CompletionImpl>;
   using RebindTraits2 = std::allocator_traits<RebindAlloc2>;
@@ -188,7 +196,8 @@ class CompletionImpl final : public Completion<void(Args...), T> {
   void destroy_defer(std::tuple<Args...>&& args) override {
     auto w = std::move(work);
     auto f = bind_and_forward(std::move(handler), std::move(args));
-    RebindAlloc2 alloc2 = boost::asio::get_associated_allocator(handler);
+    RebindAlloc2 alloc2 =
+      boost::asio::get_associated_allocator(handler, DefaultAlloc{});
     RebindTraits2::destroy(alloc2, this);
     RebindTraits2::deallocate(alloc2, this, 1);
     w.second.get_executor().defer(std::move(f), alloc2);
@@ -196,7 +205,8 @@ class CompletionImpl final : public Completion<void(Args...), T> {
   void destroy_dispatch(std::tuple<Args...>&& args) override {
     auto w = std::move(work);
     auto f = bind_and_forward(std::move(handler), std::move(args));
-    RebindAlloc2 alloc2 = boost::asio::get_associated_allocator(handler);
+    RebindAlloc2 alloc2 =
+      boost::asio::get_associated_allocator(handler, DefaultAlloc{});
     RebindTraits2::destroy(alloc2, this);
     RebindTraits2::deallocate(alloc2, this, 1);
     w.second.get_executor().dispatch(std::move(f), alloc2);
@@ -204,13 +214,15 @@ class CompletionImpl final : public Completion<void(Args...), T> {
   void destroy_post(std::tuple<Args...>&& args) override {
     auto w = std::move(work);
     auto f = bind_and_forward(std::move(handler), std::move(args));
-    RebindAlloc2 alloc2 = boost::asio::get_associated_allocator(handler);
+    RebindAlloc2 alloc2 =
+      boost::asio::get_associated_allocator(handler, DefaultAlloc{});
     RebindTraits2::destroy(alloc2, this);
     RebindTraits2::deallocate(alloc2, this, 1);
     w.second.get_executor().post(std::move(f), alloc2);
   }
   void destroy() override {
-    RebindAlloc2 alloc2 = boost::asio::get_associated_allocator(handler);
+    RebindAlloc2 alloc2 =
+      boost::asio::get_associated_allocator(handler, DefaultAlloc{});
     RebindTraits2::destroy(alloc2, this);
     RebindTraits2::deallocate(alloc2, this, 1);
   }
@@ -227,7 +239,8 @@ class CompletionImpl final : public Completion<void(Args...), T> {
  public:
   template <typename ...TArgs>
   static auto create(const Executor1& ex, Handler&& handler, TArgs&& ...args) {
-    auto alloc2 = boost::asio::get_associated_allocator(handler);
+    auto alloc2 =
+      boost::asio::get_associated_allocator(handler, DefaultAlloc{});
     using Ptr = std::unique_ptr<CompletionImpl>;
     return Ptr{new (alloc2) CompletionImpl(ex, std::move(handler),
                                            std::forward<TArgs>(args)...)};
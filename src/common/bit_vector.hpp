@@ -184,6 +184,8 @@ public:
   uint64_t size() const;
 
   const bufferlist& get_data() const;
+  /// packed elements for bulk updates; the length must not be changed
+  bufferlist& get_data();
 
   Reference operator[](uint64_t offset);
   ConstReference operator[](uint64_t offset) const;
@@ -293,6 +295,11 @@ const bufferlist& BitVector<_b>::get_data() const {
   return m_data;
 }
 
+template <uint8_t _b>
+bufferlist& BitVector<_b>::get_data() {
+  return m_data;
+}
+
 template <uint8_t _b>
 void BitVector<_b>::compute_index(uint64_t offset, uint64_t *index, uint64_t *shift) {
   *index = offset / ELEMENTS_PER_BLOCK;
@@ -1527,6 +1527,34 @@ public:
       out[i] = rawout[i];
   }
 
+  /**
+   * map a batch of inputs through the same rule
+   *
+   * The result for each xs[i] in out[i] is identical to that of
+   * do_rule(), but the workspace is set up and the choose_args are looked
+   * up once for the whole batch rather than once per input.
+   */
+  template<typename WeightVector>
+  void do_rule_batch(int rule, const std::vector<int>& xs,
+		     std::vector<std::vector<int>>& out, int maxout,
+		     const WeightVector& weight,
+		     uint64_t choose_args_index) const {
+    int rawout[maxout];
+    char work[crush_work_size(crush, maxout)];
+    crush_init_workspace(crush, work);
+    crush_choose_arg_map arg_map = choose_args_get_with_fallback(
+      choose_args_index);
+    out.resize(xs.size());
+    for (size_t j = 0; j < xs.size(); ++j) {
+      int numrep = crush_do_rule(crush, rule, xs[j], rawout, maxout,
+				 std::data(weight), std::size(weight),
+				 work, arg_map.args);
+      if (numrep < 0)
+	numrep = 0;
+      out[j].assign(rawout, rawout + numrep);
+    }
+  }
+
   int _choose_type_stack(
     CephContext *cct,
     const std::vector<std::pair<int,int>>& stack,
@@ -1212,6 +1212,28 @@ inline namespace v14_2_0 {
     int aio_operate(const std::string& oid, AioCompletion *c,
         ObjectReadOperation *op, int flags,
         bufferlist *pbl, const blkin_trace_info *trace_info);
+    /**
+     * Schedule read operations on several objects as one batch
+     *
+     * The operations are submitted together, and c completes once all
+     * of them have, with the first error seen or 0.  Per-object results
+     * are returned in the same order as oids.  aio_cancel() on c cancels
+     * every operation that has not completed yet.  c carries no object
+     * version.
+     *
+     * @param oids the objects to operate on
+     * @param c what to do when every operation is complete
+     * @param ops the operation to perform on each object
+     * @param flags flags to apply to every operation
+     * @param pbls where to store each operation's output data (or NULL)
+     * @param prvals where to store each operation's return value (or NULL)
+     * @returns 0 on success, negative error code on failure
+     */
+    int aio_operate_batch(const std::vector<std::string>& oids,
+			  AioCompletion *c,
+			  const std::vector<ObjectReadOperation*>& ops,
+			  int flags, std::vector<bufferlist> *pbls,
+			  std::vector<int> *prvals);
 
     // watch/notify
     int watch2(const std::string& o, uint64_t *handle,
@@ -30,6 +30,8 @@ struct librados::AioCompletionImpl {
   bool complete = false;
   version_t objver = 0;
   ceph_tid_t tid = 0;
+  // the sub-op tids of an aio_operate_batch, cancelled together
+  std::vector<ceph_tid_t> batch_tids;
 
   rados_callback_t callback_complete = nullptr, callback_safe = nullptr;
   void *callback_complete_arg = nullptr, *callback_safe_arg = nullptr;
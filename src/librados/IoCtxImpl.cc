@@ -749,6 +749,53 @@ int librados::IoCtxImpl::aio_operate_read(const object_t &oid,
   return 0;
 }
 
+int librados::IoCtxImpl::aio_operate_read_batch(
+  const std::vector<object_t>& oids,
+  const std::vector<::ObjectOperation*>& ops,
+  AioCompletionImpl *c, int flags,
+  std::vector<bufferlist> *pbls,
+  std::vector<int> *prvals)
+{
+  FUNCTRACE(client->cct);
+  if (oids.empty() || oids.size() != ops.size())
+    return -EINVAL;
+
+  c->is_read = true;
+  c->io = this;
+  // size the outputs up front; their elements must not move once the
+  // ops referencing them are in flight
+  if (pbls) {
+    pbls->clear();
+    pbls->resize(oids.size());
+  }
+  if (prvals)
+    prvals->assign(oids.size(), 0);
+
+  ldout(client->cct, 10) << __func__ << " " << oids.size() << " objects"
+			 << " nspace=" << oloc.nspace << dendl;
+
+  // submit back to back under one gather so the whole batch reaches the
+  // messenger together; c completes with the first error, if any
+  C_GatherBuilder gather(client->cct, new C_aio_Complete(c));
+  c->batch_tids.assign(oids.size(), 0);
+  for (size_t i = 0; i < oids.size(); ++i) {
+    Context *onack = gather.new_sub();
+    if (prvals) {
+      onack = new LambdaContext(
+	[onack, rval = &(*prvals)[i]](int r) {
+	  *rval = r;
+	  onack->complete(r);
+	});
+    }
+    Objecter::Op *objecter_op = objecter->prepare_read_op(
+      oids[i], oloc, *ops[i], snap_seq, pbls ? &(*pbls)[i] : nullptr,
+      flags | extra_op_flags, onack, nullptr);
+    objecter->op_submit(objecter_op, &c->batch_tids[i]);
+  }
+  gather.activate();
+  return 0;
+}
+
 int librados::IoCtxImpl::aio_operate(const object_t& oid,
 				     ::ObjectOperation *o, AioCompletionImpl *c,
 				     const SnapContext& snap_context, int flags,
@@ -1192,6 +1239,17 @@ int librados::IoCtxImpl::aio_getxattrs(const object_t& oid, AioCompletionImpl *c
 
 int librados::IoCtxImpl::aio_cancel(AioCompletionImpl *c)
 {
+  if (!c->batch_tids.empty()) {
+    // the gather completes c once every sub-op has been cancelled or
+    // has finished
+    int r = -ENOENT;
+    for (auto tid : c->batch_tids) {
+      if (objecter->op_cancel(tid, -ECANCELED) == 0) {
+	r = 0;
+      }
+    }
+    return r;
+  }
   return objecter->op_cancel(c->tid, -ECANCELED);
 }
 
@@ -1633,6 +1633,27 @@ int librados::IoCtx::aio_operate(const std::string& oid, AioCompletion *c,
 				       0, pbl);
 }
 
+int librados::IoCtx::aio_operate_batch(
+  const std::vector<std::string>& oids, AioCompletion *c,
+  const std::vector<ObjectReadOperation*>& ops, int flags,
+  std::vector<bufferlist> *pbls, std::vector<int> *prvals)
+{
+  std::vector<object_t> objs;
+  std::vector<::ObjectOperation*> impls;
+  objs.reserve(oids.size());
+  impls.reserve(ops.size());
+  for (auto& oid : oids)
+    objs.emplace_back(oid);
+  for (auto o : ops) {
+    if (unlikely(!o || !o->impl))
+      return -EINVAL;
+    impls.push_back(&o->impl->o);
+  }
+  return io_ctx_impl->aio_operate_read_batch(objs, impls, c->pc,
+					     translate_flags(flags),
+					     pbls, prvals);
+}
+
 // deprecated
 int librados::IoCtx::aio_operate(const std::string& oid, AioCompletion *c,
 				 librados::ObjectReadOperation *o, 
@@ -6,6 +6,8 @@
 #include "common/AsyncOpTracker.h"
 #include "common/dout.h"
 #include "librbd/ImageCtx.h"
+#include "librbd/Utils.h"
+#include "librbd/internal.h"
 #include "librbd/crypto/CryptoImageDispatch.h"
 #include "librbd/io/ImageDispatch.h"
 #include "librbd/io/ImageDispatchInterface.h"
@@ -134,12 +136,16 @@ struct ImageDispatcher<I>::PreprocessVisitor
       image_dispatch_spec(image_dispatch_spec) {
   }
 
-  bool clip_request() const {
-    auto area = (image_dispatch_spec->image_dispatch_flags &
+  ImageArea get_area() const {
+    return (image_dispatch_spec->image_dispatch_flags &
         IMAGE_DISPATCH_FLAG_CRYPTO_HEADER ? ImageArea::CRYPTO_HEADER :
                                             ImageArea::DATA);
+  }
+
+  bool clip_request() const {
     int r = util::clip_request(image_dispatcher->m_image_ctx,
-                               &image_dispatch_spec->image_extents, area);
+                               &image_dispatch_spec->image_extents,
+                               get_area());
     if (r < 0) {
       image_dispatch_spec->fail(r);
       return true;
@@ -164,14 +170,23 @@ struct ImageDispatcher<I>::PreprocessVisitor
 
   template <typename T>
   bool operator()(T&) const {
-    if (clip_request()) {
-      return true;
+    // clip and check for a writable image under a single image_lock
+    // round, but fail the request only after dropping it
+    auto image_ctx = image_dispatcher->m_image_ctx;
+    auto area = get_area();
+    int r = 0;
+    {
+      std::shared_lock image_locker{image_ctx->image_lock};
+      r = util::clip_request_locked(
+        image_ctx, &image_dispatch_spec->image_extents, area);
+      if (r == 0 &&
+          (image_ctx->snap_id != CEPH_NOSNAP || image_ctx->read_only)) {
+        r = -EROFS;
+      }
     }
 
-    std::shared_lock image_locker{image_dispatcher->m_image_ctx->image_lock};
-    if (image_dispatcher->m_image_ctx->snap_id != CEPH_NOSNAP ||
-        image_dispatcher->m_image_ctx->read_only) {
-      image_dispatch_spec->fail(-EROFS);
+    if (r < 0) {
+      image_dispatch_spec->fail(r);
       return true;
     }
     return false;
@@ -142,6 +142,13 @@ void read_parent(I *image_ctx, uint64_t object_no, ReadExtents* read_extents,
 template <typename I>
 int clip_request(I* image_ctx, Extents* image_extents, ImageArea area) {
   std::shared_lock image_locker{image_ctx->image_lock};
+  return clip_request_locked(image_ctx, image_extents, area);
+}
+
+template <typename I>
+int clip_request_locked(I* image_ctx, Extents* image_extents,
+                        ImageArea area) {
+  ceph_assert(ceph_mutex_is_locked(image_ctx->image_lock));
   for (auto &image_extent : *image_extents) {
     auto clip_len = image_extent.second;
     int r = clip_io(librbd::util::get_image_ctx(image_ctx),
@@ -232,6 +239,8 @@ template void librbd::io::util::read_parent(
     librados::snap_t snap_id, const ZTracer::Trace &trace, Context* on_finish);
 template int librbd::io::util::clip_request(
     librbd::ImageCtx* image_ctx, Extents* image_extents, ImageArea area);
+template int librbd::io::util::clip_request_locked(
+    librbd::ImageCtx* image_ctx, Extents* image_extents, ImageArea area);
 template bool librbd::io::util::trigger_copyup(
         librbd::ImageCtx *image_ctx, uint64_t object_no, IOContext io_context,
         Context* on_finish);
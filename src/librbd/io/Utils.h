@@ -38,6 +38,11 @@ void read_parent(ImageCtxT *image_ctx, uint64_t object_no,
 template <typename ImageCtxT = librbd::ImageCtx>
 int clip_request(ImageCtxT* image_ctx, Extents* image_extents, ImageArea area);
 
+// same as clip_request(), for callers already holding image_lock
+template <typename ImageCtxT = librbd::ImageCtx>
+int clip_request_locked(ImageCtxT* image_ctx, Extents* image_extents,
+                        ImageArea area);
+
 inline uint64_t get_extents_length(const Extents &extents) {
   uint64_t total_bytes = 0;
   for (auto [_, extent_length] : extents) {
@@ -8,6 +8,7 @@
 #include "librbd/ObjectMap.h"
 #include "librbd/Utils.h"
 #include "osdc/Striper.h"
+#include <array>
 #include <string>
 
 #define dout_subsys ceph_subsys_rbd
@@ -20,6 +21,70 @@ namespace object_map {
 
 using util::create_rados_callback;
 
+namespace {
+
+uint8_t diff_state_transition(uint8_t object_map_state,
+                              uint8_t prev_object_diff_state) {
+  if (object_map_state == OBJECT_EXISTS ||
+      object_map_state == OBJECT_PENDING ||
+      (object_map_state == OBJECT_EXISTS_CLEAN &&
+       prev_object_diff_state != DIFF_STATE_DATA &&
+       prev_object_diff_state != DIFF_STATE_DATA_UPDATED)) {
+    return DIFF_STATE_DATA_UPDATED;
+  } else if (object_map_state == OBJECT_NONEXISTENT &&
+             prev_object_diff_state != DIFF_STATE_HOLE &&
+             prev_object_diff_state != DIFF_STATE_HOLE_UPDATED) {
+    return DIFF_STATE_HOLE_UPDATED;
+  }
+  return prev_object_diff_state;
+}
+
+// both maps pack four 2-bit states per byte, so the transition of a whole
+// byte of objects is a lookup on the (object map, diff state) byte pair
+using PackedTransitions = std::array<std::array<uint8_t, 256>, 256>;
+
+const PackedTransitions& get_packed_transitions() {
+  static const PackedTransitions transitions = [] {
+    PackedTransitions t;
+    for (uint32_t om = 0; om < 256; ++om) {
+      for (uint32_t prev = 0; prev < 256; ++prev) {
+        uint8_t out = 0;
+        for (uint32_t shift = 0; shift < 8; shift += 2) {
+          out |= diff_state_transition((om >> shift) & 3,
+                                       (prev >> shift) & 3) << shift;
+        }
+        t[om][prev] = out;
+      }
+    }
+    return t;
+  }();
+  return transitions;
+}
+
+// returns the number of leading objects that were updated
+uint64_t apply_packed_transitions(BitVector<2>& object_map,
+                                  BitVector<2>* object_diff_state,
+                                  uint64_t object_count) {
+  static_assert(BitVector<2>::ELEMENTS_PER_BLOCK == 4);
+  uint64_t byte_count = object_count / BitVector<2>::ELEMENTS_PER_BLOCK;
+  if (byte_count == 0) {
+    return 0;
+  }
+
+  auto& transitions = get_packed_transitions();
+  auto om = reinterpret_cast<const uint8_t*>(object_map.get_data().c_str());
+  auto diff = reinterpret_cast<uint8_t*>(
+    object_diff_state->get_data().c_str());
+  for (uint64_t i = 0; i < byte_count; ++i) {
+    diff[i] = transitions[om[i]][diff[i]];
+  }
+  // bytes were modified behind the bufferlist's back
+  object_diff_state->get_data().invalidate_crc();
+  return byte_count * BitVector<2>::ELEMENTS_PER_BLOCK;
+}
+
+} // anonymous namespace
+
 template <typename I>
 void DiffRequest<I>::send() {
   auto cct = m_image_ctx->cct;
@@ -188,24 +253,18 @@ void DiffRequest<I>::handle_load_object_map(int r) {
   }
 
   uint64_t overlap = std::min(m_object_map.size(), prev_object_diff_state_size);
-  auto it = m_object_map.begin();
-  auto overlap_end_it = it + overlap;
-  auto diff_it = m_object_diff_state->begin();
   uint64_t i = 0;
+  if (!cct->_conf->subsys.should_gather<dout_subsys, 20>()) {
+    // per-object logging is off, so update whole bytes at a time
+    i = apply_packed_transitions(m_object_map, m_object_diff_state, overlap);
+  }
+  auto it = m_object_map.begin() + i;
+  auto overlap_end_it = m_object_map.begin() + overlap;
+  auto diff_it = m_object_diff_state->begin() + i;
   for (; it != overlap_end_it; ++it, ++diff_it, ++i) {
     uint8_t object_map_state = *it;
     uint8_t prev_object_diff_state = *diff_it;
-    if (object_map_state == OBJECT_EXISTS ||
-        object_map_state == OBJECT_PENDING ||
-        (object_map_state == OBJECT_EXISTS_CLEAN &&
-         prev_object_diff_state != DIFF_STATE_DATA &&
-         prev_object_diff_state != DIFF_STATE_DATA_UPDATED)) {
-      *diff_it = DIFF_STATE_DATA_UPDATED;
-    } else if (object_map_state == OBJECT_NONEXISTENT &&
-               prev_object_diff_state != DIFF_STATE_HOLE &&
-               prev_object_diff_state != DIFF_STATE_HOLE_UPDATED) {
-      *diff_it = DIFF_STATE_HOLE_UPDATED;
-    }
+    *diff_it = diff_state_transition(object_map_state, prev_object_diff_state);
 
     ldout(cct, 20) << "object state: " << i << " "
                    << static_cast<uint32_t>(prev_object_diff_state)
@@ -828,6 +828,7 @@ void OSDMonitor::update_from_paxos(bool *need_bootstrap)
     OSDMap::Incremental inc(inc_bl);
     err = osdmap.apply_incremental(inc);
     ceph_assert(err == 0);
+    mapping.note_incremental(osdmap, inc);
 
     if (!t)
       t.reset(new MonitorDBStore::Transaction);
@@ -5417,7 +5418,8 @@ namespace {
     CSUM_TYPE, CSUM_MAX_BLOCK, CSUM_MIN_BLOCK, FINGERPRINT_ALGORITHM,
     PG_AUTOSCALE_MODE, PG_NUM_MIN, TARGET_SIZE_BYTES, TARGET_SIZE_RATIO,
     PG_AUTOSCALE_BIAS, DEDUP_TIER, DEDUP_CHUNK_ALGORITHM, 
-    DEDUP_CDC_CHUNK_SIZE, POOL_EIO, BULK, PG_NUM_MAX };
+    DEDUP_CDC_CHUNK_SIZE, POOL_EIO, BULK, PG_NUM_MAX,
+    MCLOCK_CLIENT_RES, MCLOCK_CLIENT_WGT, MCLOCK_CLIENT_LIM };
 
   std::set<osd_pool_get_choices>
     subtract_second_from_first(const std::set<osd_pool_get_choices>& first,
@@ -6168,7 +6170,10 @@ bool OSDMonitor::preprocess_command(MonOpRequestRef op)
       {"dedup_tier", DEDUP_TIER},
       {"dedup_chunk_algorithm", DEDUP_CHUNK_ALGORITHM},
       {"dedup_cdc_chunk_size", DEDUP_CDC_CHUNK_SIZE},
-      {"bulk", BULK}
+      {"bulk", BULK},
+      {"mclock_client_res", MCLOCK_CLIENT_RES},
+      {"mclock_client_wgt", MCLOCK_CLIENT_WGT},
+      {"mclock_client_lim", MCLOCK_CLIENT_LIM}
     };
 
     typedef std::set<osd_pool_get_choices> choices_set_t;
@@ -6398,6 +6403,9 @@ bool OSDMonitor::preprocess_command(MonOpRequestRef op)
 	  case DEDUP_TIER:
 	  case DEDUP_CHUNK_ALGORITHM:
 	  case DEDUP_CDC_CHUNK_SIZE:
+	  case MCLOCK_CLIENT_RES:
+	  case MCLOCK_CLIENT_WGT:
+	  case MCLOCK_CLIENT_LIM:
             pool_opts_t::key_t key = pool_opts_t::get_opt_desc(i->first).key;
             if (p->opts.is_set(key)) {
               if(*it == CSUM_TYPE) {
@@ -6561,6 +6569,9 @@ bool OSDMonitor::preprocess_command(MonOpRequestRef op)
 	  case DEDUP_TIER:
 	  case DEDUP_CHUNK_ALGORITHM:
 	  case DEDUP_CDC_CHUNK_SIZE:
+	  case MCLOCK_CLIENT_RES:
+	  case MCLOCK_CLIENT_WGT:
+	  case MCLOCK_CLIENT_LIM:
 	    for (i = ALL_CHOICES.begin(); i != ALL_CHOICES.end(); ++i) {
 	      if (i->second == *it)
 		break;
@@ -8912,6 +8923,17 @@ int OSDMonitor::prepare_command_pool_set(const cmdmap_t& cmdmap,
         ss << "error parsing int value '" << val << "': " << interr;
         return -EINVAL;
       }
+    } else if (var == "mclock_client_res" ||
+	       var == "mclock_client_wgt" ||
+	       var == "mclock_client_lim") {
+      if (interr.length()) {
+        ss << "error parsing int value '" << val << "': " << interr;
+        return -EINVAL;
+      }
+      if (n < 0) {
+	ss << "pool " << var << " cannot be negative";
+	return -EINVAL;
+      }
     }
 
     pool_opts_t::opt_desc_t desc = pool_opts_t::get_opt_desc(var);
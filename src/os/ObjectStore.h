@@ -551,6 +551,41 @@ public:
      return total;
    }
 
+  /**
+   * verify -- verify an object range and fold its data into a crc32c digest
+   *
+   * Equivalent to read() followed by crc32c of the returned data with
+   * *digest as seed, but lets the implementation check the data against
+   * whatever integrity metadata it keeps without handing the data to the
+   * caller. Used by deep scrub.
+   *
+   * Note: as with read(), a range past the end of the object verifies
+   * 0 bytes and leaves the digest unchanged.
+   *
+   * @param cid collection for object
+   * @param oid oid of object
+   * @param offset location offset of first byte to be verified
+   * @param len number of bytes to be verified
+   * @param digest in/out crc32c, seeded by the caller
+   * @param op_flags is CEPH_OSD_OP_FLAG_*
+   * @returns number of bytes verified on success, or negative error code
+   *          on failure (-EIO on a checksum mismatch).
+   */
+  virtual int verify(
+    CollectionHandle &c,
+    const ghobject_t& oid,
+    uint64_t offset,
+    size_t len,
+    uint32_t *digest,
+    uint32_t op_flags = 0) {
+    ceph::buffer::list bl;
+    int r = read(c, oid, offset, len, bl, op_flags);
+    if (r > 0) {
+      *digest = bl.crc32c(*digest);
+    }
+    return r;
+  }
+
   /**
    * dump_onode -- dumps onode metadata in human readable form,
      intended primiarily for debugging
@@ -5133,6 +5133,11 @@ void BlueStore::_init_logger()
   b.add_time_avg(l_bluestore_read_lat, "read_lat",
 		 "Average read latency",
 		 "r_l", PerfCountersBuilder::PRIO_CRITICAL);
+  b.add_time_avg(l_bluestore_verify_lat, "verify_lat",
+		 "Average verify (deep scrub) latency");
+  b.add_u64_counter(l_bluestore_verify_csum_bytes, "verify_csum_bytes",
+		    "Bytes verified whose digest was derived from stored checksums",
+		    NULL, 0, unit_t(UNIT_BYTES));
   //****************************************
 
   // kv_thread latencies
@@ -11611,6 +11616,287 @@ int BlueStore::_do_readv(
   return bl.length();
 }
 
+int BlueStore::verify(
+  CollectionHandle &c_,
+  const ghobject_t& oid,
+  uint64_t offset,
+  size_t length,
+  uint32_t *digest,
+  uint32_t op_flags)
+{
+  auto start = mono_clock::now();
+  Collection *c = static_cast<Collection *>(c_.get());
+  const coll_t &cid = c->get_cid();
+  dout(15) << __func__ << " " << cid << " " << oid
+	   << " 0x" << std::hex << offset << "~" << length << std::dec
+	   << dendl;
+  if (!c->exists)
+    return -ENOENT;
+
+  int r;
+  {
+    std::shared_lock l(c->lock);
+    auto start1 = mono_clock::now();
+    OnodeRef o = c->get_onode(oid, false);
+    log_latency("get_onode@verify",
+      l_bluestore_read_onode_meta_lat,
+      mono_clock::now() - start1,
+      cct->_conf->bluestore_log_op_age);
+    if (!o || !o->exists) {
+      r = -ENOENT;
+      goto out;
+    }
+
+    if (offset == length && offset == 0)
+      length = o->onode.size;
+
+    r = _do_verify(c, o, offset, length, digest, op_flags);
+    if (r == -EIO) {
+      logger->inc(l_bluestore_read_eio);
+    }
+  }
+
+ out:
+  if (r >= 0 && _debug_data_eio(oid)) {
+    r = -EIO;
+    derr << __func__ << " " << c->cid << " " << oid << " INJECT EIO" << dendl;
+  }
+  dout(10) << __func__ << " " << cid << " " << oid
+	   << " 0x" << std::hex << offset << "~" << length
+	   << " digest 0x" << *digest << std::dec
+	   << " = " << r << dendl;
+  log_latency(__func__,
+    l_bluestore_verify_lat,
+    mono_clock::now() - start,
+    cct->_conf->bluestore_log_op_age);
+  return r;
+}
+
+// Fold blob data into a running crc32c. bl holds the blob's data
+// starting at blob offset b_off. Whole csum chunks have already been
+// verified against the blob's stored crc32c (seeded with -1), and since
+// crc32c is linear, crc(seed, chunk) == stored ^ crc(seed ^ -1, zeros);
+// only partial chunks have to be hashed again.
+static uint32_t crc32c_append_from_csum(
+  uint32_t crc,
+  const bluestore_blob_t& blob,
+  uint64_t b_off,
+  const bufferlist& bl,
+  uint64_t *csum_bytes)
+{
+  const uint64_t chunk_size = blob.get_csum_chunk_size();
+  auto it = bl.cbegin();
+  uint64_t pos = 0;
+  while (pos < bl.length()) {
+    uint64_t x_off = b_off + pos;
+    uint64_t front = x_off % chunk_size;
+    uint64_t l = std::min<uint64_t>(bl.length() - pos, chunk_size - front);
+    if (front == 0 && l == chunk_size) {
+      uint32_t stored = blob.get_csum_item(x_off / chunk_size);
+      crc = stored ^ ceph_crc32c(crc ^ 0xffffffff, nullptr, l);
+      it += l;
+      *csum_bytes += l;
+    } else {
+      crc = it.crc32c(l, crc);
+    }
+    pos += l;
+  }
+  return crc;
+}
+
+int BlueStore::_generate_verify_digest(
+  OnodeRef o,
+  uint64_t offset,
+  size_t length,
+  ready_regions_t& ready_regions,
+  vector<bufferlist>& compressed_blob_bls,
+  blobs2read_t& blobs2read,
+  bool* csum_error,
+  uint32_t* digest)
+{
+  // a region either carries data that has to be hashed (cached, or
+  // decompressed, or without usable crc32c csums), or data of a crc32c
+  // blob whose stored csums can be folded into the digest directly
+  struct verify_region_t {
+    bufferlist bl;
+    const bluestore_blob_t *blob = nullptr;
+    uint64_t blob_xoffset = 0;
+  };
+  std::map<uint64_t, verify_region_t> regions;
+  for (auto& [logical_offset, bl] : ready_regions) {
+    regions[logical_offset].bl = std::move(bl);
+  }
+
+  const bool use_stored_csum = !cct->_conf->bluestore_ignore_data_csum;
+  auto p = compressed_blob_bls.begin();
+  for (auto& [bptr, r2r] : blobs2read) {
+    const bluestore_blob_t& blob = bptr->get_blob();
+    dout(20) << __func__ << "  blob " << *bptr << " need "
+             << r2r << dendl;
+    if (blob.is_compressed()) {
+      ceph_assert(p != compressed_blob_bls.end());
+      bufferlist& compressed_bl = *p++;
+      if (_verify_csum(o, &blob, 0, compressed_bl,
+                       r2r.front().regs.front().logical_offset) < 0) {
+        *csum_error = true;
+        return -EIO;
+      }
+      bufferlist raw_bl;
+      auto r = _decompress(compressed_bl, &raw_bl);
+      if (r < 0)
+        return r;
+      for (auto& req : r2r) {
+        for (auto& reg : req.regs) {
+          regions[reg.logical_offset].bl.substr_of(
+            raw_bl, reg.blob_xoffset, reg.length);
+        }
+      }
+    } else {
+      for (auto& req : r2r) {
+        if (_verify_csum(o, &blob, req.r_off, req.bl,
+                         req.regs.front().logical_offset) < 0) {
+          *csum_error = true;
+          return -EIO;
+        }
+        for (const auto& reg : req.regs) {
+          auto& vr = regions[reg.logical_offset];
+          vr.bl.substr_of(req.bl, reg.front, reg.length);
+          if (use_stored_csum &&
+              blob.csum_type == Checksummer::CSUM_CRC32C) {
+            vr.blob = &blob;
+            vr.blob_xoffset = reg.blob_xoffset;
+          }
+        }
+      }
+    }
+  }
+
+  // fold everything into the digest in logical order
+  uint32_t crc = *digest;
+  uint64_t csum_bytes = 0;
+  auto pr = regions.begin();
+  uint64_t pos = offset;
+  const uint64_t end = offset + length;
+  while (pos < end) {
+    if (pr != regions.end() && pr->first == pos) {
+      auto& vr = pr->second;
+      if (vr.blob) {
+        crc = crc32c_append_from_csum(crc, *vr.blob, vr.blob_xoffset, vr.bl,
+                                      &csum_bytes);
+      } else {
+        crc = vr.bl.crc32c(crc);
+      }
+      pos += vr.bl.length();
+      ++pr;
+    } else {
+      uint64_t l = end - pos;
+      if (pr != regions.end()) {
+        ceph_assert(pr->first > pos);
+        l = pr->first - pos;
+      }
+      // holes read back as zeros
+      crc = ceph_crc32c(crc, nullptr, l);
+      pos += l;
+    }
+  }
+  ceph_assert(pos == end);
+  ceph_assert(pr == regions.end());
+  logger->inc(l_bluestore_verify_csum_bytes, csum_bytes);
+  *digest = crc;
+  return 0;
+}
+
+int BlueStore::_do_verify(
+  Collection *c,
+  OnodeRef o,
+  uint64_t offset,
+  size_t length,
+  uint32_t *digest,
+  uint32_t op_flags,
+  uint64_t retry_count)
+{
+  FUNCTRACE(cct);
+  int r = 0;
+
+  dout(20) << __func__ << " 0x" << std::hex << offset << "~" << length
+           << " size 0x" << o->onode.size << " (" << std::dec
+           << o->onode.size << ")" << dendl;
+
+  if (offset >= o->onode.size) {
+    return r;
+  }
+  if (offset + length > o->onode.size) {
+    length = o->onode.size - offset;
+  }
+
+  auto start = mono_clock::now();
+  o->extent_map.fault_range(db, offset, length);
+  log_latency(__func__,
+    l_bluestore_read_onode_meta_lat,
+    mono_clock::now() - start,
+    cct->_conf->bluestore_log_op_age);
+  _dump_onode<30>(cct, *o);
+
+  // like a deep-scrub read: only dirty buffers are taken from the cache,
+  // everything else comes from the device and is checked against the
+  // blob checksums. Nothing is added to the cache.
+  ready_regions_t ready_regions;
+  blobs2read_t blobs2read;
+  _read_cache(o, offset, length, BufferSpace::BYPASS_CLEAN_CACHE,
+              ready_regions, blobs2read);
+
+  start = mono_clock::now();
+  vector<bufferlist> compressed_blob_bls;
+  IOContext ioc(cct, NULL, !cct->_conf->bluestore_fail_eio);
+  r = _prepare_read_ioc(blobs2read, &compressed_blob_bls, &ioc);
+  // we always issue aio for reading, so errors other than EIO are not allowed
+  if (r < 0)
+    return r;
+
+  int64_t num_ios = blobs2read.size();
+  if (ioc.has_pending_aios()) {
+    num_ios = ioc.get_num_ios();
+    bdev->aio_submit(&ioc);
+    dout(20) << __func__ << " waiting for aio" << dendl;
+    ioc.aio_wait();
+    r = ioc.get_return_value();
+    if (r < 0) {
+      ceph_assert(r == -EIO); // no other errors allowed
+      return -EIO;
+    }
+  }
+  log_latency_fn(__func__,
+    l_bluestore_read_wait_aio_lat,
+    mono_clock::now() - start,
+    cct->_conf->bluestore_log_op_age,
+    [&](auto lat) { return ", num_ios = " + stringify(num_ios); }
+  );
+
+  bool csum_error = false;
+  uint32_t crc = *digest;
+  r = _generate_verify_digest(o, offset, length, ready_regions,
+                              compressed_blob_bls, blobs2read,
+                              &csum_error, &crc);
+  if (csum_error) {
+    // see _do_read
+    if (retry_count >= cct->_conf->bluestore_retry_disk_reads) {
+      return -EIO;
+    }
+    return _do_verify(c, o, offset, length, digest, op_flags, retry_count + 1);
+  }
+  if (r < 0) {
+    return r;
+  }
+  *digest = crc;
+  if (retry_count) {
+    logger->inc(l_bluestore_reads_with_retries);
+    dout(5) << __func__ << " verify at 0x" << std::hex << offset << "~" << length
+            << " failed " << std::dec << retry_count
+            << " times before succeeding" << dendl;
+  }
+  return length;
+}
+
 int BlueStore::dump_onode(CollectionHandle &c_,
   const ghobject_t& oid,
   const string& section_name,
@@ -113,6 +113,8 @@ enum {
   l_bluestore_read_eio,
   l_bluestore_reads_with_retries,
   l_bluestore_read_lat,
+  l_bluestore_verify_lat,
+  l_bluestore_verify_csum_bytes,
   //****************************************
 
   // kv_thread latencies
@@ -3106,6 +3108,25 @@ private:
     uint32_t op_flags = 0,
     uint64_t retry_count = 0);
 
+  int _generate_verify_digest(
+    OnodeRef o,
+    uint64_t offset,
+    size_t length,
+    ready_regions_t& ready_regions,
+    std::vector<ceph::buffer::list>& compressed_blob_bls,
+    blobs2read_t& blobs2read,
+    bool* csum_error,
+    uint32_t* digest);
+
+  int _do_verify(
+    Collection *c,
+    OnodeRef o,
+    uint64_t offset,
+    size_t len,
+    uint32_t *digest,
+    uint32_t op_flags = 0,
+    uint64_t retry_count = 0);
+
   int _fiemap(CollectionHandle &c_, const ghobject_t& oid,
 	      uint64_t offset, size_t len, interval_set<uint64_t>& destset);
 public:
@@ -3121,6 +3142,14 @@ public:
     ceph::buffer::list& bl,
     uint32_t op_flags) override;
 
+  int verify(
+    CollectionHandle &c_,
+    const ghobject_t& oid,
+    uint64_t offset,
+    size_t len,
+    uint32_t *digest,
+    uint32_t op_flags = 0) override;
+
   int dump_onode(CollectionHandle &c, const ghobject_t& oid,
     const std::string& section_name, ceph::Formatter *f) override;
 
@@ -1048,22 +1048,50 @@ void ECBackend::handle_sub_read(
         dout(25) << __func__ << " case2: going to do fragmented read." << dendl;
         int subchunk_size =
           sinfo.get_chunk_size() / ec_impl->get_sub_chunk_count();
-        bool error = false;
-        for (int m = 0; m < (int)j->get<1>() && !error;
-             m += sinfo.get_chunk_size()) {
-          for (auto &&k:op.subchunks.find(i->first)->second) {
-            bufferlist bl0;
-            r = store->read(
-                ch,
-                ghobject_t(i->first, ghobject_t::NO_GEN, shard),
-                j->get<0>() + m + (k.first)*subchunk_size,
-                (k.second)*subchunk_size,
-                bl0, j->get<2>());
-            if (r < 0) {
-              error = true;
-              break;
+        // gather every sub-chunk run of every chunk into a single readv
+        // so the store can issue (and merge) the fragments together.
+        // that only preserves the reply layout if the runs are ascending
+        // and disjoint, which is what clay hands out.
+        const auto &runs = op.subchunks.find(i->first)->second;
+        bool ascending = true;
+        for (unsigned n = 1; n < runs.size(); ++n) {
+          if (runs[n].first < runs[n - 1].first + runs[n - 1].second) {
+            ascending = false;
+            break;
+          }
+        }
+        if (ascending) {
+          interval_set<uint64_t> extents;
+          for (int m = 0; m < (int)j->get<1>();
+               m += sinfo.get_chunk_size()) {
+            for (auto &&k : runs) {
+              extents.insert(j->get<0>() + m + (k.first)*subchunk_size,
+                             (k.second)*subchunk_size);
+            }
+          }
+          r = store->readv(
+              ch,
+              ghobject_t(i->first, ghobject_t::NO_GEN, shard),
+              extents,
+              bl, j->get<2>());
+        } else {
+          bool error = false;
+          for (int m = 0; m < (int)j->get<1>() && !error;
+               m += sinfo.get_chunk_size()) {
+            for (auto &&k : runs) {
+              bufferlist bl0;
+              r = store->read(
+                  ch,
+                  ghobject_t(i->first, ghobject_t::NO_GEN, shard),
+                  j->get<0>() + m + (k.first)*subchunk_size,
+                  (k.second)*subchunk_size,
+                  bl0, j->get<2>());
+              if (r < 0) {
+                error = true;
+                break;
+              }
+              bl.claim_append(bl0);
             }
-            bl.claim_append(bl0);
           }
         }
       }
@@ -2221,6 +2249,12 @@ void ECBackend::objects_read_async(
 
   uint32_t flags = 0;
   extent_set es;
+  // if every read falls inside the same data chunk of its stripe, the
+  // shard holding that chunk can serve them alone
+  bool direct = !fast_read &&
+    ec_impl->get_sub_chunk_count() == 1 &&
+    cct->_conf.get_val<bool>("osd_ec_direct_chunk_reads");
+  int direct_chunk = -1;
   for (list<pair<boost::tuple<uint64_t, uint64_t, uint32_t>,
 	 pair<bufferlist*, Context*> > >::const_iterator i =
 	 to_read.begin();
@@ -2232,6 +2266,24 @@ void ECBackend::objects_read_async(
 
     es.union_insert(tmp.first, tmp.second);
     flags |= i->first.get<2>();
+
+    uint64_t off = i->first.get<0>();
+    uint64_t len = i->first.get<1>();
+    if (direct && len > 0 && tmp.second == sinfo.get_stripe_width()) {
+      int first = (off - tmp.first) / sinfo.get_chunk_size();
+      int last = (off + len - 1 - tmp.first) / sinfo.get_chunk_size();
+      if (first != last ||
+	  (direct_chunk >= 0 && first != direct_chunk)) {
+	direct = false;
+      } else {
+	direct_chunk = first;
+      }
+    } else {
+      direct = false;
+    }
+  }
+  if (!direct) {
+    direct_chunk = -1;
   }
 
   if (!es.empty()) {
@@ -2325,7 +2377,8 @@ void ECBackend::objects_read_async(
 	cb(this,
 	   hoid,
 	   to_read,
-	   on_complete)));
+	   on_complete)),
+    direct_chunk);
 }
 
 struct CallClientContexts :
@@ -2334,12 +2387,17 @@ struct CallClientContexts :
   ECBackend *ec;
   ECBackend::ClientAsyncReadStatus *status;
   list<boost::tuple<uint64_t, uint64_t, uint32_t> > to_read;
+  int direct_chunk;
+  int direct_shard;
   CallClientContexts(
     hobject_t hoid,
     ECBackend *ec,
     ECBackend::ClientAsyncReadStatus *status,
-    const list<boost::tuple<uint64_t, uint64_t, uint32_t> > &to_read)
-    : hoid(hoid), ec(ec), status(status), to_read(to_read) {}
+    const list<boost::tuple<uint64_t, uint64_t, uint32_t> > &to_read,
+    int direct_chunk = -1,
+    int direct_shard = -1)
+    : hoid(hoid), ec(ec), status(status), to_read(to_read),
+      direct_chunk(direct_chunk), direct_shard(direct_shard) {}
   void finish(pair<RecoveryMessages *, ECBackend::read_result_t &> &in) override {
     ECBackend::read_result_t &res = in.second;
     extent_map result;
@@ -2353,6 +2411,28 @@ struct CallClientContexts :
 	  make_pair(read.get<0>(), read.get<1>()));
       ceph_assert(res.returned.front().get<0>() == adjusted.first);
       ceph_assert(res.returned.front().get<1>() == adjusted.second);
+      if (direct_chunk >= 0) {
+	auto &returned = res.returned.front().get<2>();
+	auto j = std::find_if(
+	  returned.begin(), returned.end(),
+	  [this](const auto &p) {
+	    return p.first.shard == shard_id_t(direct_shard);
+	  });
+	if (j != returned.end()) {
+	  // the wanted chunk of each stripe, straight from its shard
+	  const uint64_t chunk_size = ec->sinfo.get_chunk_size();
+	  uint64_t stripe_off = adjusted.first + direct_chunk * chunk_size;
+	  for (uint64_t off = 0; off < j->second.length(); off += chunk_size) {
+	    bufferlist bl;
+	    bl.substr_of(j->second, off,
+			 std::min(chunk_size, j->second.length() - off));
+	    result.insert(stripe_off, bl.length(), std::move(bl));
+	    stripe_off += ec->sinfo.get_stripe_width();
+	  }
+	  res.returned.pop_front();
+	  continue;
+	}
+      }
       map<int, bufferlist> to_decode;
       bufferlist bl;
       for (map<pg_shard_t, bufferlist>::iterator j =
@@ -2391,7 +2471,8 @@ void ECBackend::objects_read_and_reconstruct(
     std::list<boost::tuple<uint64_t, uint64_t, uint32_t> >
   > &reads,
   bool fast_read,
-  GenContextURef<map<hobject_t,pair<int, extent_map> > &&> &&func)
+  GenContextURef<map<hobject_t,pair<int, extent_map> > &&> &&func,
+  int direct_chunk)
 {
   in_progress_client_reads.emplace_back(
     reads.size(), std::move(func));
@@ -2402,8 +2483,19 @@ void ECBackend::objects_read_and_reconstruct(
 
   map<hobject_t, set<int>> obj_want_to_read;
   set<int> want_to_read;
-  get_want_to_read_shards(&want_to_read);
-    
+  int direct_shard = -1;
+  if (direct_chunk >= 0) {
+    ceph_assert(!fast_read);
+    const vector<int> &chunk_mapping = ec_impl->get_chunk_mapping();
+    direct_shard = (int)chunk_mapping.size() > direct_chunk ?
+      chunk_mapping[direct_chunk] : direct_chunk;
+    want_to_read.insert(direct_shard);
+    dout(20) << __func__ << ": direct read of chunk " << direct_chunk
+	     << " from shard " << direct_shard << dendl;
+  } else {
+    get_want_to_read_shards(&want_to_read);
+  }
+
   map<hobject_t, read_request_t> for_read_op;
   for (auto &&to_read: reads) {
     map<pg_shard_t, vector<pair<int, int>>> shards;
@@ -2419,7 +2511,9 @@ void ECBackend::objects_read_and_reconstruct(
       to_read.first,
       this,
       &(in_progress_client_reads.back()),
-      to_read.second);
+      to_read.second,
+      direct_chunk,
+      direct_shard);
     for_read_op.insert(
       make_pair(
 	to_read.first,
@@ -2542,13 +2636,13 @@ int ECBackend::be_deep_scrub(
   if (stride % sinfo.get_chunk_size())
     stride += sinfo.get_chunk_size() - (stride % sinfo.get_chunk_size());
 
-  bufferlist bl;
-  r = store->read(
+  uint32_t digest = pos.data_hash.digest();
+  r = store->verify(
     ch,
     ghobject_t(
       poid, ghobject_t::NO_GEN, get_parent()->whoami_shard().shard),
     pos.data_pos,
-    stride, bl,
+    stride, &digest,
     fadvise_flags);
   if (r < 0) {
     dout(20) << __func__ << "  " << poid << " got "
@@ -2556,16 +2650,14 @@ int ECBackend::be_deep_scrub(
     o.read_error = true;
     return 0;
   }
-  if (bl.length() % sinfo.get_chunk_size()) {
+  if (r % sinfo.get_chunk_size()) {
     dout(20) << __func__ << "  " << poid << " got "
 	     << r << " on read, not chunk size " << sinfo.get_chunk_size() << " aligned"
 	     << dendl;
     o.read_error = true;
     return 0;
   }
-  if (r > 0) {
-    pos.data_hash << bl;
-  }
+  pos.data_hash = bufferhash(digest);
   pos.data_pos += r;
   if (r == (int)stride) {
     return -EINPROGRESS;
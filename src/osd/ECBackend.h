@@ -135,12 +135,18 @@ public:
    * still only perform a client read from shards in the acting std::set.  This
    * ensures that we won't ever have to restart a client initiated read in
    * check_recovery_sources.
+   *
+   * If direct_chunk is non-negative, the caller only needs that data
+   * chunk out of every stripe it reads.  We then read just the shard
+   * holding it and skip the decode; if that shard is unavailable we
+   * read and decode as usual.
    */
   void objects_read_and_reconstruct(
     const std::map<hobject_t, std::list<boost::tuple<uint64_t, uint64_t, uint32_t> >
     > &reads,
     bool fast_read,
-    GenContextURef<std::map<hobject_t,std::pair<int, extent_map> > &&> &&func);
+    GenContextURef<std::map<hobject_t,std::pair<int, extent_map> > &&> &&func,
+    int direct_chunk = -1);
 
   friend struct CallClientContexts;
   struct ClientAsyncReadStatus {
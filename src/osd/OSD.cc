@@ -1137,6 +1137,118 @@ entity_name_t OSDService::get_cluster_msgr_name() const
   return cluster_messenger->get_myname();
 }
 
+bool OSDService::queue_peering_batch(int peer, const MessageRef& m,
+				     epoch_t epoch)
+{
+  const uint64_t batch_max =
+    cct->_conf.get_val<uint64_t>("osd_peering_batch_max");
+  if (batch_max == 0) {
+    return false;
+  }
+  bool is_info;
+  pg_notify_t n;
+  switch (m->get_type()) {
+  case MSG_OSD_PG_NOTIFY2:
+    is_info = false;
+    n = static_cast<const MOSDPGNotify2*>(m.get())->notify;
+    break;
+  case MSG_OSD_PG_INFO2:
+    {
+      auto i = static_cast<const MOSDPGInfo2*>(m.get());
+      if (i->lease || i->lease_ack) {
+	// only the per-pg message carries read leases
+	return false;
+      }
+      is_info = true;
+      n = pg_notify_t(i->spgid.shard, i->info.pgid.shard,
+		      i->min_epoch, i->epoch_sent,
+		      i->info, PastIntervals());
+    }
+    break;
+  default:
+    return false;
+  }
+
+  bool schedule_flush = false;
+  {
+    std::lock_guard l(peering_batch_lock);
+    auto& batch = peering_batch[peer];
+    if (batch.runs.empty() || batch.runs.back().is_info != is_info ||
+	batch.runs.back().epoch != epoch) {
+      batch.runs.push_back(peering_batch_run_t{is_info, epoch, {}});
+    }
+    batch.runs.back().entries.push_back(std::move(n));
+    ++batch.size;
+    peering_batch_queued = true;
+    if (batch.size >= batch_max) {
+      _send_peering_batch(peer, batch);
+      peering_batch.erase(peer);
+      peering_batch_queued = !peering_batch.empty();
+    } else if (!peering_batch_flush_scheduled) {
+      peering_batch_flush_scheduled = schedule_flush = true;
+    }
+  }
+  if (schedule_flush) {
+    mono_timer.add_event(
+      cct->_conf.get_val<std::chrono::milliseconds>("osd_peering_batch_delay"),
+      [this]() {
+	flush_peering_batch();
+      });
+  }
+  return true;
+}
+
+void OSDService::flush_peering_batch(int peer)
+{
+  if (peer >= 0 && !peering_batch_queued) {
+    // nothing held (always the case with batching disabled); keep the
+    // per-message path off the lock
+    return;
+  }
+  std::lock_guard l(peering_batch_lock);
+  if (peer < 0) {
+    for (auto& [p, batch] : peering_batch) {
+      _send_peering_batch(p, batch);
+    }
+    peering_batch.clear();
+    peering_batch_queued = false;
+    peering_batch_flush_scheduled = false;
+    return;
+  }
+  auto p = peering_batch.find(peer);
+  if (p != peering_batch.end()) {
+    _send_peering_batch(peer, p->second);
+    peering_batch.erase(p);
+    peering_batch_queued = !peering_batch.empty();
+  }
+}
+
+void OSDService::_send_peering_batch(int peer, peering_batch_t& batch)
+{
+  ceph_assert(ceph_mutex_is_locked_by_me(peering_batch_lock));
+  // send while still holding peering_batch_lock so that a pg's batched
+  // messages can't be overtaken by the next one it sends directly
+  OSDMapRef osdmap = get_osdmap();
+  ConnectionRef con = get_con_osd_cluster(peer, osdmap->get_epoch());
+  if (!con) {
+    dout(20) << __func__ << " skipping osd." << peer << " (NULL con)" << dendl;
+    return;
+  }
+  dout(20) << __func__ << " osd." << peer << " " << batch.size
+	   << " entries in " << batch.runs.size() << " messages" << dendl;
+  maybe_share_map(con.get(), osdmap);
+  for (auto& run : batch.runs) {
+    // stamp each message with the epoch of the pgs that generated it
+    if (run.is_info) {
+      con->send_message2(make_message<MOSDPGInfo>(
+	run.epoch, std::move(run.entries)));
+    } else {
+      con->send_message2(make_message<MOSDPGNotify>(
+	run.epoch, std::move(run.entries)));
+    }
+  }
+}
+
 void OSDService::queue_want_pg_temp(pg_t pgid,
 				    const vector<int>& want,
 				    bool forced)
@@ -5889,6 +6001,11 @@ void OSD::heartbeat()
   if (load_for_logger) {
     logger->set(l_osd_loadavg, load_for_logger.value());
   }
+  {
+    auto [op_lat_sum_ns, op_count] = logger->get_tavg_ns(l_osd_op_lat);
+    service.get_scrub_services().update_client_io_stats(op_lat_sum_ns,
+							op_count);
+  }
   dout(30) << "heartbeat checking stats" << dendl;
 
   // refresh peer list and osd stats
@@ -8969,6 +9086,11 @@ void OSD::dispatch_context(PeeringCtx &ctx, PG *pg, OSDMapRef curmap,
       }
       service.maybe_share_map(con.get(), curmap);
       for (auto m : ls) {
+	if (service.queue_peering_batch(osd, m, curmap->get_epoch())) {
+	  continue;
+	}
+	// anything already batched for osd must go out first
+	service.flush_peering_batch(osd);
 	con->send_message2(m);
       }
       ls.clear();
@@ -9062,7 +9184,7 @@ void OSD::handle_fast_pg_notify(MOSDPGNotify* m)
 	  true,
 	  new PGCreateInfo(
 	    pgid,
-	    p.query_epoch,
+	    p.epoch_sent,
 	    p.info.history,
 	    p.past_intervals,
 	    false)
@@ -10241,6 +10363,7 @@ void OSDShard::consume_map(
   dout(10) << new_osdmap->get_epoch()
            << " (was " << (old_osdmap ? old_osdmap->get_epoch() : 0) << ")"
 	   << dendl;
+  scheduler->update_pool_qos(*new_osdmap);
   int queued = 0;
 
   // check slots
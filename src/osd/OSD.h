@@ -261,6 +261,33 @@ public:
   }
   entity_name_t get_cluster_msgr_name() const;
 
+  // -- batched peering messages --
+  /// hold a pg's notify/info to peer so it can go out in one MOSDPGNotify or
+  /// MOSDPGInfo with other pgs'; returns false if m must be sent as is.
+  /// epoch is the map epoch of the pg that generated m.
+  bool queue_peering_batch(int peer, const MessageRef& m, epoch_t epoch);
+  /// send whatever is held for peer, or for every peer if peer < 0
+  void flush_peering_batch(int peer = -1);
+private:
+  // consecutive messages of one type and map epoch; runs are sent in the
+  // order they were queued so that each pg's messages keep their order
+  struct peering_batch_run_t {
+    bool is_info;
+    epoch_t epoch;
+    std::vector<pg_notify_t> entries;
+  };
+  struct peering_batch_t {
+    std::vector<peering_batch_run_t> runs;
+    size_t size = 0;
+  };
+  ceph::mutex peering_batch_lock =
+    ceph::make_mutex("OSDService::peering_batch_lock");
+  std::map<int, peering_batch_t> peering_batch;
+  /// lets senders skip peering_batch_lock when nothing is held
+  std::atomic<bool> peering_batch_queued = false;
+  bool peering_batch_flush_scheduled = false;
+  void _send_peering_batch(int peer, peering_batch_t& batch);
+
 
 public:
 
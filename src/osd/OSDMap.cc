@@ -1898,12 +1898,22 @@ void OSDMap::dedup(const OSDMap *o, OSDMap *n)
     n->osd_addrs = o->osd_addrs;
   }
 
-  // does crush match?
-  ceph::buffer::list oc, nc;
-  encode(*o->crush, oc, CEPH_FEATURES_SUPPORTED_DEFAULT);
-  encode(*n->crush, nc, CEPH_FEATURES_SUPPORTED_DEFAULT);
-  if (oc.contents_equal(nc)) {
+  // does crush match?  luminous+ maps bump crush_version on every crush
+  // change, so equal versions mean equal maps and we can skip encoding
+  // both of them.
+  if (o->crush == n->crush) {
+    // already shared
+  } else if (o->require_osd_release >= ceph_release_t::luminous &&
+	     n->require_osd_release >= ceph_release_t::luminous &&
+	     o->crush_version == n->crush_version) {
     n->crush = o->crush;
+  } else {
+    ceph::buffer::list oc, nc;
+    encode(*o->crush, oc, CEPH_FEATURES_SUPPORTED_DEFAULT);
+    encode(*n->crush, nc, CEPH_FEATURES_SUPPORTED_DEFAULT);
+    if (oc.contents_equal(nc)) {
+      n->crush = o->crush;
+    }
   }
 
   // does pg_temp match?
@@ -1920,6 +1930,11 @@ void OSDMap::dedup(const OSDMap *o, OSDMap *n)
   if (o->osd_uuid->size() == n->osd_uuid->size() &&
       *o->osd_uuid == *n->osd_uuid)
     n->osd_uuid = o->osd_uuid;
+
+  // does primary affinity match?
+  if (o->osd_primary_affinity && n->osd_primary_affinity &&
+      *o->osd_primary_affinity == *n->osd_primary_affinity)
+    n->osd_primary_affinity = o->osd_primary_affinity;
 }
 
 void OSDMap::clean_temps(CephContext *cct,
@@ -5612,6 +5627,105 @@ void OSDMap::get_pool_ids_by_osd(CephContext *cct,
   }
 }
 
+bool OSDMap::get_pgs_changed_by(const Incremental& inc,
+				set<int64_t> *pools,
+				set<pg_t> *pgs) const
+{
+  ceph_assert(pools);
+  ceph_assert(pgs);
+  if (inc.fullmap.length() ||
+      inc.crush.length() ||
+      inc.new_max_osd >= 0) {
+    return false;
+  }
+
+  // pool changes (including pg_num/size) can move any pg in the pool
+  for (auto& [pool, p] : inc.new_pools) {
+    pools->insert(pool);
+  }
+
+  // explicit per-pg remappings
+  for (auto& [pg, v] : inc.new_pg_temp) {
+    pgs->insert(pg);
+  }
+  for (auto& [pg, osd] : inc.new_primary_temp) {
+    pgs->insert(pg);
+  }
+  for (auto& [pg, v] : inc.new_pg_upmap) {
+    pgs->insert(pg);
+  }
+  for (auto& [pg, v] : inc.new_pg_upmap_items) {
+    pgs->insert(pg);
+  }
+  for (auto& [pg, osd] : inc.new_pg_upmap_primary) {
+    pgs->insert(pg);
+  }
+  pgs->insert(inc.old_pg_upmap.begin(), inc.old_pg_upmap.end());
+  pgs->insert(inc.old_pg_upmap_items.begin(), inc.old_pg_upmap_items.end());
+  pgs->insert(inc.old_pg_upmap_primary.begin(),
+	      inc.old_pg_upmap_primary.end());
+
+  // osds whose existence, up/down state, weight or primary affinity changed
+  set<int> osds;
+  for (auto& [osd, state] : inc.new_state) {
+    // legacy encoding: 0 means flip CEPH_OSD_UP (see apply_incremental)
+    int s = state ? state : CEPH_OSD_UP;
+    if (s & (CEPH_OSD_EXISTS | CEPH_OSD_UP)) {
+      osds.insert(osd);
+    }
+  }
+  for (auto& [osd, addrs] : inc.new_up_client) {
+    osds.insert(osd);
+  }
+  for (auto& [osd, w] : inc.new_weight) {
+    osds.insert(osd);
+  }
+  for (auto& [osd, a] : inc.new_primary_affinity) {
+    osds.insert(osd);
+  }
+  if (osds.empty()) {
+    return true;
+  }
+
+  // crush can only place a pg on an osd its rule can reach
+  map<int, bool> rule_affected;
+  for (auto& [pool, p] : get_pools()) {
+    int rule = p.get_crush_rule();
+    auto r = rule_affected.find(rule);
+    if (r == rule_affected.end()) {
+      map<int, float> weights;
+      bool affected = true;
+      if (crush->get_rule_weight_osd_map(rule, &weights) >= 0) {
+	affected = std::any_of(
+	  osds.begin(), osds.end(),
+	  [&weights](int osd) { return weights.count(osd) > 0; });
+      }
+      r = rule_affected.emplace(rule, affected).first;
+    }
+    if (r->second) {
+      pools->insert(pool);
+    }
+  }
+
+  // but upmaps and pg_temp can put a pg anywhere
+  for (auto p : *pg_temp) {
+    pgs->insert(p.first);
+  }
+  for (auto& [pg, osd] : *primary_temp) {
+    pgs->insert(pg);
+  }
+  for (auto& [pg, v] : pg_upmap) {
+    pgs->insert(pg);
+  }
+  for (auto& [pg, v] : pg_upmap_items) {
+    pgs->insert(pg);
+  }
+  for (auto& [pg, osd] : pg_upmap_primaries) {
+    pgs->insert(pg);
+  }
+  return true;
+}
+
 template <typename F>
 class OSDUtilizationDumper : public CrushTreeDumper::Dumper<F> {
 public:
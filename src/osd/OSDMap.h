@@ -1567,6 +1567,24 @@ public:
       pg_upmap_items.count(pg);
   }
 
+  /**
+   * get the pgs that may map differently than in the previous epoch
+   *
+   * Given the incremental that produced this map, work out which pools
+   * and pgs could have a different up or acting set.  OSD state, weight
+   * and primary-affinity changes only affect the pools whose crush rule
+   * can reach the OSD (plus any pg with an explicit remapping), while
+   * pg_temp/upmap changes only affect the pgs they name.
+   *
+   * @param inc [in] the incremental that was applied to produce this map
+   * @param pools [out] pools all of whose pgs may have moved
+   * @param pgs [out] other pgs that may have moved
+   * @return false if any pg may have moved (e.g., crush changed)
+   */
+  bool get_pgs_changed_by(const Incremental& inc,
+			  std::set<int64_t> *pools,
+			  std::set<pg_t> *pgs) const;
+
   bool check_full(const std::set<pg_shard_t> &missing_on) const {
     for (auto shard : missing_on) {
       if (get_state(shard.osd) & CEPH_OSD_FULL)
@@ -15,7 +15,8 @@ MEMPOOL_DEFINE_OBJECT_FACTORY(OSDMapMapping, osdmapmapping,
 
 // ensure that we have a PoolMappings for each pool and that
 // the dimensions (pg_num and size) match up.
-void OSDMapMapping::_init_mappings(const OSDMap& osdmap)
+void OSDMapMapping::_init_mappings(const OSDMap& osdmap,
+				   std::set<int64_t> *rebuilt_pools)
 {
   num_pgs = 0;
   auto q = pools.begin();
@@ -39,6 +40,9 @@ void OSDMapMapping::_init_mappings(const OSDMap& osdmap)
     pools.emplace(p.first, PoolMapping(p.second.get_size(),
 				       p.second.get_pg_num(),
 				       p.second.is_erasure()));
+    if (rebuilt_pools) {
+      rebuilt_pools->insert(p.first);
+    }
   }
   pools.erase(q, pools.end());
   ceph_assert(pools.size() == osdmap.get_pools().size());
@@ -59,6 +63,86 @@ void OSDMapMapping::update(const OSDMap& osdmap, pg_t pgid)
   _update_range(osdmap, pgid.pool(), pgid.ps(), pgid.ps() + 1);
 }
 
+void OSDMapMapping::note_incremental(const OSDMap& osdmap,
+				     const OSDMap::Incremental& inc)
+{
+  ceph_assert(inc.epoch == osdmap.get_epoch());
+  if (pending_changes.size() >= max_pending_changes) {
+    // we have fallen far behind; the gap forces a full remap
+    pending_changes.clear();
+  }
+  Changes& c = pending_changes[inc.epoch];
+  c.all = !osdmap.get_pgs_changed_by(inc, &c.pools, &c.pgs);
+}
+
+// work out which pgs need remapping to bring us from our epoch to
+// osdmap's.  returns false if everything does.
+bool OSDMapMapping::_get_changed_pgs(
+  const OSDMap& osdmap,
+  const std::set<int64_t>& rebuilt_pools,
+  std::vector<pg_t> *pgs)
+{
+  // the table already reflects anything up to our epoch
+  pending_changes.erase(pending_changes.begin(),
+			pending_changes.upper_bound(epoch));
+  if (epoch == 0 ||
+      epoch > osdmap.get_epoch() ||
+      pending_changes.size() != osdmap.get_epoch() - epoch) {
+    // we never mapped, or missed an incremental
+    return false;
+  }
+  std::set<int64_t> changed_pools = rebuilt_pools;
+  std::set<pg_t> changed_pgs;
+  for (auto& [e, c] : pending_changes) {
+    if (c.all) {
+      return false;
+    }
+    changed_pools.insert(c.pools.begin(), c.pools.end());
+    changed_pgs.insert(c.pgs.begin(), c.pgs.end());
+  }
+  for (auto pool : changed_pools) {
+    const pg_pool_t *pi = osdmap.get_pg_pool(pool);
+    if (!pi) {
+      continue;
+    }
+    for (unsigned ps = 0; ps < pi->get_pg_num(); ++ps) {
+      pgs->push_back(pg_t(ps, pool));
+    }
+  }
+  for (auto pgid : changed_pgs) {
+    if (changed_pools.count(pgid.pool())) {
+      continue;
+    }
+    const pg_pool_t *pi = osdmap.get_pg_pool(pgid.pool());
+    if (!pi || pgid.ps() >= pi->get_pg_num()) {
+      continue;
+    }
+    pgs->push_back(pgid);
+  }
+  return true;
+}
+
+std::unique_ptr<OSDMapMapping::MappingJob> OSDMapMapping::start_update(
+  const OSDMap& osdmap,
+  ParallelPGMapper& mapper,
+  unsigned pgs_per_item)
+{
+  std::set<int64_t> rebuilt_pools;
+  _init_mappings(osdmap, &rebuilt_pools);
+  std::unique_ptr<MappingJob> job(new MappingJob(&osdmap, this));
+  std::vector<pg_t> pgs;
+  if (!_get_changed_pgs(osdmap, rebuilt_pools, &pgs)) {
+    mapper.queue(job.get(), pgs_per_item, {});
+  } else if (!pgs.empty()) {
+    mapper.queue(job.get(), pgs_per_item, pgs);
+  } else {
+    // nothing can have moved; the job is already complete
+    job->finish = ceph_clock_now();
+    _finish(osdmap);
+  }
+  return job;
+}
+
 void OSDMapMapping::_build_rmap(const OSDMap& osdmap)
 {
   acting_rmap.resize(osdmap.get_max_osd());
@@ -9,11 +9,10 @@
 #include <map>
 
 #include "osd/osd_types.h"
+#include "osd/OSDMap.h"
 #include "common/WorkQueue.h"
 #include "common/Cond.h"
 
-class OSDMap;
-
 /// work queue to perform work on batches of pgids on multiple CPUs
 class ParallelPGMapper {
 public:
@@ -266,7 +265,21 @@ private:
   epoch_t epoch = 0;
   uint64_t num_pgs = 0;
 
-  void _init_mappings(const OSDMap& osdmap);
+  /// pgs that may have moved in each epoch since the one we last mapped
+  struct Changes {
+    bool all = false;
+    std::set<int64_t> pools;
+    std::set<pg_t> pgs;
+  };
+  std::map<epoch_t, Changes> pending_changes;
+  /// past this many unmapped epochs we stop tracking and remap everything
+  static constexpr size_t max_pending_changes = 100;
+
+  void _init_mappings(const OSDMap& osdmap,
+		      std::set<int64_t> *rebuilt_pools = nullptr);
+  bool _get_changed_pgs(const OSDMap& osdmap,
+			const std::set<int64_t>& rebuilt_pools,
+			std::vector<pg_t> *pgs);
   void _update_range(
     const OSDMap& map,
     int64_t pool,
@@ -286,10 +299,12 @@ private:
   struct MappingJob : public ParallelPGMapper::Job {
     OSDMapMapping *mapping;
     MappingJob(const OSDMap *osdmap, OSDMapMapping *m)
-      : Job(osdmap), mapping(m) {
-      mapping->_start(*osdmap);
+      : Job(osdmap), mapping(m) {}
+    void process(const std::vector<pg_t>& pgs) override {
+      for (auto pgid : pgs) {
+	mapping->update(*osdmap, pgid);
+      }
     }
-    void process(const std::vector<pg_t>& pgs) override {}
     void process(int64_t pool, unsigned ps_begin, unsigned ps_end) override {
       mapping->_update_range(*osdmap, pool, ps_begin, ps_end);
     }
@@ -348,14 +363,15 @@ public:
 
   void update(const OSDMap& map, pg_t pgid);
 
+  /// note the incremental that produced osdmap, so that the next
+  /// start_update() only needs to remap the pgs it could have moved
+  void note_incremental(const OSDMap& osdmap,
+			const OSDMap::Incremental& inc);
+
   std::unique_ptr<MappingJob> start_update(
     const OSDMap& map,
     ParallelPGMapper& mapper,
-    unsigned pgs_per_item) {
-    std::unique_ptr<MappingJob> job(new MappingJob(&map, this));
-    mapper.queue(job.get(), pgs_per_item, {});
-    return job;
-  }
+    unsigned pgs_per_item);
 
   epoch_t get_epoch() const {
     return epoch;
@@ -496,7 +496,7 @@ void PG::_finish_recovery(Context* c)
   }
 }
 
-void PG::start_recovery_op(const hobject_t& soid)
+void PG::start_recovery_op(const hobject_t& soid, bool shares_slot)
 {
   dout(10) << "start_recovery_op " << soid
 #ifdef DEBUG_RECOVERY_OIDS
@@ -508,7 +508,12 @@ void PG::start_recovery_op(const hobject_t& soid)
 #ifdef DEBUG_RECOVERY_OIDS
   recovering_oids.insert(soid);
 #endif
-  osd->start_recovery_op(this, soid);
+  if (shares_slot) {
+    // another op of ours already holds the osd-wide slot
+    recovery_ops_sharing_slot.insert(soid);
+  } else {
+    osd->start_recovery_op(this, soid);
+  }
 }
 
 void PG::finish_recovery_op(const hobject_t& soid, bool dequeue)
@@ -524,7 +529,9 @@ void PG::finish_recovery_op(const hobject_t& soid, bool dequeue)
   ceph_assert(recovering_oids.count(soid));
   recovering_oids.erase(recovering_oids.find(soid));
 #endif
-  osd->finish_recovery_op(this, soid, dequeue);
+  if (!recovery_ops_sharing_slot.erase(soid)) {
+    osd->finish_recovery_op(this, soid, dequeue);
+  }
 
   if (!dequeue) {
     queue_recovery();
@@ -723,6 +730,11 @@ void PG::clear_recovery_state()
 
   finish_sync_event = 0;
 
+  // finish slot sharers by name first, so that only the ops that hold
+  // an osd-wide slot are released below
+  while (!recovery_ops_sharing_slot.empty()) {
+    finish_recovery_op(*recovery_ops_sharing_slot.begin(), true);
+  }
   hobject_t soid;
   while (recovery_ops_active > 0) {
 #ifdef DEBUG_RECOVERY_OIDS
@@ -767,6 +779,8 @@ void PG::send_cluster_message(
   if (share_map_update) {
     osd->maybe_share_map(con.get(), get_osdmap());
   }
+  // don't let m overtake peering messages we've batched for target
+  osd->flush_peering_batch(target);
   osd->send_message_osd_cluster(m, con.get());
 }
 
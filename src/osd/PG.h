@@ -891,6 +891,8 @@ protected:
   bool recovery_queued;
 
   int recovery_ops_active;
+  /// recovery ops that share an osd-wide recovery slot with another op
+  std::set<hobject_t> recovery_ops_sharing_slot;
   std::set<pg_shard_t> waiting_on_backfill;
 #ifdef DEBUG_RECOVERY_OIDS
   multiset<hobject_t> recovering_oids;
@@ -1200,7 +1202,7 @@ protected:
   void cancel_recovery();
   void clear_recovery_state();
   virtual void _clear_recovery_state() = 0;
-  void start_recovery_op(const hobject_t& soid);
+  void start_recovery_op(const hobject_t& soid, bool shares_slot = false);
   void finish_recovery_op(const hobject_t& soid, bool dequeue=false);
 
   virtual void _split_into(pg_t child_pgid, PG *child, unsigned split_bits) = 0;
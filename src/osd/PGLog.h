@@ -146,10 +146,12 @@ public:
    * plus some methods to manipulate it all.
    */
   struct IndexedLog : public pg_log_t {
-    mutable ceph::unordered_map<hobject_t,pg_log_entry_t*> objects;  // ptrs into log.  be careful!
-    mutable ceph::unordered_map<osd_reqid_t,pg_log_entry_t*> caller_ops;
-    mutable ceph::unordered_multimap<osd_reqid_t,pg_log_entry_t*> extra_caller_ops;
-    mutable ceph::unordered_map<osd_reqid_t,pg_log_dup_t*> dup_index;
+    // the indexes live in the osd_pglog mempool alongside the entries they
+    // point into, so that dump_mempools reflects the full cost of the log.
+    mutable mempool::osd_pglog::unordered_map<hobject_t,pg_log_entry_t*> objects;  // ptrs into log.  be careful!
+    mutable mempool::osd_pglog::unordered_map<osd_reqid_t,pg_log_entry_t*> caller_ops;
+    mutable mempool::osd_pglog::unordered_multimap<osd_reqid_t,pg_log_entry_t*> extra_caller_ops;
+    mutable mempool::osd_pglog::unordered_map<osd_reqid_t,pg_log_dup_t*> dup_index;
 
     // recovery pointers
     std::list<pg_log_entry_t>::iterator complete_to; // not inclusive of referenced item
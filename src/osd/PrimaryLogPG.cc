@@ -13848,6 +13848,11 @@ uint64_t PrimaryLogPG::recover_backfill(
   unsigned ops = 0;
   vector<boost::tuple<hobject_t, eversion_t, pg_shard_t> > to_remove;
   set<hobject_t> add_to_stat;
+  const uint64_t small_object_size =
+    cct->_conf.get_val<Option::size_t>("osd_backfill_small_object_size");
+  const uint64_t small_objects_per_op =
+    cct->_conf.get_val<uint64_t>("osd_backfill_small_objects_per_op");
+  uint64_t small_objects = 0;
 
   for (set<pg_shard_t>::const_iterator i = get_backfill_targets().begin();
        i != get_backfill_targets().end();
@@ -13996,14 +14001,28 @@ uint64_t PrimaryLogPG::recover_backfill(
 	  vector<pg_shard_t> all_push = need_ver_targs;
 	  all_push.insert(all_push.end(), missing_targs.begin(), missing_targs.end());
 
+	  // small objects without omap share an op slot, so that a batch
+	  // of them goes out in a single push message per target.  only
+	  // the first of each batch counts against osd_recovery_max_active.
+	  bool shares_slot = false;
+	  if (small_object_size > 0 &&
+	      obc->obs.oi.size <= small_object_size &&
+	      !obc->obs.oi.is_omap()) {
+	    shares_slot = small_objects++ % small_objects_per_op != 0;
+	  }
+
 	  handle.reset_tp_timeout();
-	  int r = prep_backfill_object_push(backfill_info.begin, obj_v, obc, all_push, h);
+	  int r = prep_backfill_object_push(backfill_info.begin, obj_v, obc,
+					    all_push, h, shares_slot);
 	  if (r < 0) {
 	    *work_started = true;
 	    dout(0) << __func__ << " Error " << r << " trying to backfill " << backfill_info.begin << dendl;
 	    break;
 	  }
-	  ops++;
+	  osd->logger->inc(l_osd_backfill_objects);
+	  if (!shares_slot) {
+	    ops++;
+	  }
 	} else {
 	  *work_started = true;
 	  dout(20) << "backfill blocking on " << backfill_info.begin
@@ -14155,9 +14174,11 @@ int PrimaryLogPG::prep_backfill_object_push(
   hobject_t oid, eversion_t v,
   ObjectContextRef obc,
   vector<pg_shard_t> peers,
-  PGBackend::RecoveryHandle *h)
+  PGBackend::RecoveryHandle *h,
+  bool shares_slot)
 {
-  dout(10) << __func__ << " " << oid << " v " << v << " to peers " << peers << dendl;
+  dout(10) << __func__ << " " << oid << " v " << v << " to peers " << peers
+	   << (shares_slot ? " (sharing a recovery slot)" : "") << dendl;
   ceph_assert(!peers.empty());
 
   backfills_in_flight.insert(oid);
@@ -14165,7 +14186,7 @@ int PrimaryLogPG::prep_backfill_object_push(
 
   ceph_assert(!recovering.count(oid));
 
-  start_recovery_op(oid);
+  start_recovery_op(oid, shares_slot);
   recovering.insert(make_pair(oid, obc));
 
   int r = pgbackend->recover_object(
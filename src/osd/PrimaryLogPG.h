@@ -1290,7 +1290,8 @@ protected:
   int prep_backfill_object_push(
     hobject_t oid, eversion_t v, ObjectContextRef obc,
     std::vector<pg_shard_t> peers,
-    PGBackend::RecoveryHandle *h);
+    PGBackend::RecoveryHandle *h,
+    bool shares_slot = false);
   void send_remove_op(const hobject_t& oid, eversion_t v, pg_shard_t peer);
 
 
@@ -132,6 +132,7 @@ void ReplicatedBackend::run_recovery_op(
   send_pushes(priority, h->pushes);
   send_pulls(priority, h->pulls);
   send_recovery_deletes(priority, h->deletes);
+  prefetch_pushes(h->pushes);
   delete h;
 }
 
@@ -653,13 +654,15 @@ int ReplicatedBackend::be_deep_scrub(
       pos.data_hash = bufferhash(-1);
     }
 
-    bufferlist bl;
-    r = store->read(
+    // let the store verify the data against its own checksums and fold
+    // it into the digest without handing it to us
+    uint32_t digest = pos.data_hash.digest();
+    r = store->verify(
       ch,
       ghobject_t(
 	poid, ghobject_t::NO_GEN, get_parent()->whoami_shard().shard),
       pos.data_pos,
-      cct->_conf->osd_deep_scrub_stride, bl,
+      cct->_conf->osd_deep_scrub_stride, &digest,
       fadvise_flags);
     if (r < 0) {
       dout(20) << __func__ << "  " << poid << " got "
@@ -667,9 +670,7 @@ int ReplicatedBackend::be_deep_scrub(
       o.read_error = true;
       return 0;
     }
-    if (r > 0) {
-      pos.data_hash << bl;
-    }
+    pos.data_hash = bufferhash(digest);
     pos.data_pos += r;
     if (static_cast<uint64_t>(r) == cct->_conf->osd_deep_scrub_stride) {
       dout(20) << __func__ << "  " << poid << " more data, digest so far 0x"
@@ -928,6 +929,7 @@ void ReplicatedBackend::do_push_reply(OpRequestRef op)
   map<pg_shard_t, vector<PushOp> > _replies;
   _replies[from].swap(replies);
   send_pushes(m->get_priority(), _replies);
+  prefetch_pushes(_replies);
 }
 
 Message * ReplicatedBackend::generate_subop(
@@ -1982,6 +1984,47 @@ void ReplicatedBackend::send_pushes(int prio, map<pg_shard_t, vector<PushOp> > &
   }
 }
 
+void ReplicatedBackend::prefetch_pushes(
+  const map<pg_shard_t, vector<PushOp> > &pushes)
+{
+  if (!cct->_conf.get_val<bool>("osd_recovery_push_prefetch"))
+    return;
+  // read the next chunk of each object we just pushed, so that it is
+  // ready to go when the push reply comes back
+  for (auto &&[peer, ops] : pushes) {
+    for (auto &&op : ops) {
+      auto p = pushing.find(op.soid);
+      if (p == pushing.end())
+	continue;
+      auto q = p->second.find(peer);
+      if (q == p->second.end())
+	continue;
+      PushInfo &pi = q->second;
+      if (pi.prefetched ||
+	  pi.recovery_progress.data_complete ||
+	  pi.recovery_progress.error)
+	continue;
+      PushOp next;
+      ObjectRecoveryProgress next_progress;
+      object_stat_sum_t next_stat;
+      int r = build_push_op(
+	pi.recovery_info,
+	pi.recovery_progress, &next_progress, &next,
+	&next_stat);
+      if (r < 0) {
+	// handle_push_reply will retry the read and deal with the error
+	dout(10) << __func__ << ": " << op.soid << " error " << r << dendl;
+	continue;
+      }
+      dout(20) << __func__ << ": " << op.soid << " to osd." << peer
+	       << " " << next_progress << dendl;
+      pi.prefetched = std::move(next);
+      pi.prefetched_progress = next_progress;
+      pi.prefetched_stat = next_stat;
+    }
+  }
+}
+
 void ReplicatedBackend::send_pulls(int prio, map<pg_shard_t, vector<PullOp> > &pulls)
 {
   for (map<pg_shard_t, vector<PullOp> >::iterator i = pulls.begin();
@@ -2211,10 +2254,18 @@ bool ReplicatedBackend::handle_push_reply(
 	       << pi->recovery_progress.data_recovered_to
 	       << " of " << pi->recovery_info.copy_subset << dendl;
       ObjectRecoveryProgress new_progress;
-      int r = build_push_op(
-	pi->recovery_info,
-	pi->recovery_progress, &new_progress, reply,
-	&(pi->stat));
+      int r = 0;
+      if (pi->prefetched) {
+	*reply = std::move(*pi->prefetched);
+	pi->prefetched.reset();
+	new_progress = pi->prefetched_progress;
+	pi->stat.add(pi->prefetched_stat);
+      } else {
+	r = build_push_op(
+	  pi->recovery_info,
+	  pi->recovery_progress, &new_progress, reply,
+	  &(pi->stat));
+      }
       // Handle the case of a read error right after we wrote, which is
       // hopefully extremely rare.
       if (r < 0) {
@@ -171,6 +171,11 @@ private:
     object_stat_sum_t stat;
     ObcLockManager lock_manager;
 
+    /// next chunk, read while the previous one is on the wire
+    std::optional<PushOp> prefetched;
+    ObjectRecoveryProgress prefetched_progress;
+    object_stat_sum_t prefetched_stat;
+
     void dump(ceph::Formatter *f) const {
       {
 	f->open_object_section("recovery_progress");
@@ -260,6 +265,8 @@ private:
   void _failed_pull(pg_shard_t from, const hobject_t &soid);
 
   void send_pushes(int prio, std::map<pg_shard_t, std::vector<PushOp> > &pushes);
+  void prefetch_pushes(
+    const std::map<pg_shard_t, std::vector<PushOp> > &pushes);
   void prep_push_op_blank(const hobject_t& soid, PushOp *op);
   void send_pulls(
     int priority,
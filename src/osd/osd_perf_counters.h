@@ -57,6 +57,7 @@ enum {
 
   l_osd_rop,
   l_osd_rbytes,
+  l_osd_backfill_objects,
 
   l_osd_loadavg,
   l_osd_cached_crc,
@@ -1375,7 +1375,13 @@ static opt_mapping_t opt_mapping = boost::assign::map_list_of
            ("dedup_cdc_chunk_size", pool_opts_t::opt_desc_t(
 	     pool_opts_t::DEDUP_CDC_CHUNK_SIZE, pool_opts_t::INT))
 	   ("pg_num_max", pool_opts_t::opt_desc_t(
-             pool_opts_t::PG_NUM_MAX, pool_opts_t::INT));
+             pool_opts_t::PG_NUM_MAX, pool_opts_t::INT))
+	   ("mclock_client_res", pool_opts_t::opt_desc_t(
+	     pool_opts_t::MCLOCK_CLIENT_RES, pool_opts_t::INT))
+	   ("mclock_client_wgt", pool_opts_t::opt_desc_t(
+	     pool_opts_t::MCLOCK_CLIENT_WGT, pool_opts_t::INT))
+	   ("mclock_client_lim", pool_opts_t::opt_desc_t(
+	     pool_opts_t::MCLOCK_CLIENT_LIM, pool_opts_t::INT));
 
 bool pool_opts_t::is_opt_name(const std::string& name)
 {
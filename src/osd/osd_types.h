@@ -1078,6 +1078,9 @@ public:
     DEDUP_CHUNK_ALGORITHM,
     DEDUP_CDC_CHUNK_SIZE,
     PG_NUM_MAX, // max pg_num
+    MCLOCK_CLIENT_RES, // mclock client reservation (iops)
+    MCLOCK_CLIENT_WGT, // mclock client weight
+    MCLOCK_CLIENT_LIM, // mclock client limit (iops)
   };
 
   enum type_t {
@@ -53,6 +53,9 @@ public:
   // Apply config changes to the scheduler (if any)
   virtual void update_configuration() = 0;
 
+  // Apply per-pool client QoS settings from the osdmap (if any)
+  virtual void update_pool_qos(const OSDMap &osdmap) = 0;
+
   // Destructor
   virtual ~OpScheduler() {};
 };
@@ -142,6 +145,10 @@ public:
     // no-op
   }
 
+  void update_pool_qos(const OSDMap &osdmap) final {
+    // no-op
+  }
+
   ~ClassedOpQueueScheduler() final {};
 };
 
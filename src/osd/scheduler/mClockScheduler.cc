@@ -71,16 +71,117 @@ void mClockScheduler::ClientRegistry::update_from_config(const ConfigProxy &conf
     conf.get_val<uint64_t>("osd_mclock_scheduler_background_best_effort_res"),
     conf.get_val<uint64_t>("osd_mclock_scheduler_background_best_effort_wgt"),
     conf.get_val<uint64_t>("osd_mclock_scheduler_background_best_effort_lim"));
+
+  // profiles inherit unset values from the default client info, this
+  // runs on the config observer thread so leave the update to the shard
+  profiles_dirty = true;
+}
+
+void mClockScheduler::ClientRegistry::refresh_profiles()
+{
+  if (profiles_dirty.load() && profiles_dirty.exchange(false)) {
+    update_profile_client_infos();
+  }
+}
+
+void mClockScheduler::ClientRegistry::update_profile_client_infos()
+{
+  // Update in place where possible, the queue holds pointers to
+  // the entries of profile_client_infos
+  for (auto it = profile_client_infos.begin();
+       it != profile_client_infos.end(); ) {
+    if (profile_allocs.count(it->first)) {
+      ++it;
+    } else {
+      it = profile_client_infos.erase(it);
+    }
+  }
+  for (const auto& [profile_id, allocs] : profile_allocs) {
+    double res = allocs.res ?
+      allocs.res : default_external_client_info.reservation;
+    double wgt = allocs.wgt ?
+      allocs.wgt : default_external_client_info.weight;
+    double lim = allocs.lim ?
+      allocs.lim : default_external_client_info.limit;
+    auto it = profile_client_infos.find(profile_id);
+    if (it == profile_client_infos.end()) {
+      profile_client_infos.emplace(profile_id, dmc::ClientInfo(res, wgt, lim));
+    } else {
+      it->second.update(res, wgt, lim);
+    }
+  }
+}
+
+bool mClockScheduler::ClientRegistry::update_profile_allocs(
+  std::map<profile_id_t, ClientAllocs> &&allocs,
+  std::set<profile_id_t> *toggled)
+{
+  bool changed = false;
+  auto i = allocs.begin();
+  auto j = profile_allocs.begin();
+  while (i != allocs.end() || j != profile_allocs.end()) {
+    if (j == profile_allocs.end() ||
+	(i != allocs.end() && i->first < j->first)) {
+      toggled->insert(i->first);
+      ++i;
+    } else if (i == allocs.end() || j->first < i->first) {
+      toggled->insert(j->first);
+      ++j;
+    } else {
+      changed = changed ||
+	i->second.res != j->second.res ||
+	i->second.wgt != j->second.wgt ||
+	i->second.lim != j->second.lim;
+      ++i;
+      ++j;
+    }
+  }
+  if (!changed && toggled->empty()) {
+    return false;
+  }
+  profile_allocs = std::move(allocs);
+  profiles_dirty = false;
+  update_profile_client_infos();
+  return true;
+}
+
+bool mClockScheduler::ClientRegistry::has_stale_profile(
+  const OSDMap &osdmap) const
+{
+  for (const auto& [profile_id, allocs] : profile_allocs) {
+    if (!osdmap.have_pg_pool(static_cast<int64_t>(profile_id))) {
+      return true;
+    }
+  }
+  return false;
 }
 
 const dmc::ClientInfo *mClockScheduler::ClientRegistry::get_external_client(
   const client_profile_id_t &client) const
 {
   auto ret = external_client_infos.find(client);
-  if (ret == external_client_infos.end())
-    return &default_external_client_info;
-  else
+  if (ret != external_client_infos.end()) {
     return &(ret->second);
+  }
+  auto pret = profile_client_infos.find(client.profile_id);
+  if (pret != profile_client_infos.end()) {
+    return &(pret->second);
+  }
+  return &default_external_client_info;
+}
+
+void mClockScheduler::ClientRegistry::dump_profiles(ceph::Formatter &f) const
+{
+  f.open_array_section("profiles");
+  for (const auto& [profile_id, info] : profile_client_infos) {
+    f.open_object_section("profile");
+    f.dump_unsigned("profile_id", profile_id);
+    f.dump_float("reservation", info.reservation);
+    f.dump_float("weight", info.weight);
+    f.dump_float("limit", info.limit);
+    f.close_section();
+  }
+  f.close_section();
 }
 
 const dmc::ClientInfo *mClockScheduler::ClientRegistry::get_info(
@@ -396,6 +497,87 @@ void mClockScheduler::update_configuration()
   cct->_conf.apply_changes(nullptr);
 }
 
+void mClockScheduler::update_pool_qos(const OSDMap &osdmap)
+{
+  client_registry.refresh_profiles();
+
+  // Setting or clearing a pool option bumps the pool's last_change, so
+  // only look at the options if a pool changed since the last map or a
+  // pool with a profile went away
+  bool pools_changed = client_registry.has_stale_profile(osdmap);
+  for (auto it = osdmap.get_pools().begin();
+       !pools_changed && it != osdmap.get_pools().end();
+       ++it) {
+    pools_changed = it->second.get_last_change() > pool_qos_epoch;
+  }
+  pool_qos_epoch = osdmap.get_epoch();
+  if (!pools_changed) {
+    return;
+  }
+
+  // Pool allocations are per OSD, split them evenly across the op shards
+  // the same way the profile allocations are
+  auto per_shard = [this](int64_t v) -> uint64_t {
+    if (v <= 0) {
+      return 0;
+    }
+    return std::max<uint64_t>(
+      static_cast<uint64_t>(std::round(static_cast<double>(v) / num_shards)),
+      default_min);
+  };
+
+  std::map<profile_id_t, ClientAllocs> allocs;
+  for (const auto& [pool_id, pool] : osdmap.get_pools()) {
+    int64_t res = 0, wgt = 0, lim = 0;
+    pool.opts.get(pool_opts_t::MCLOCK_CLIENT_RES, &res);
+    pool.opts.get(pool_opts_t::MCLOCK_CLIENT_WGT, &wgt);
+    pool.opts.get(pool_opts_t::MCLOCK_CLIENT_LIM, &lim);
+    if (res <= 0 && wgt <= 0 && lim <= 0) {
+      continue;
+    }
+    allocs.emplace(
+      static_cast<profile_id_t>(pool_id),
+      ClientAllocs(per_shard(res), std::max<int64_t>(wgt, 0), per_shard(lim)));
+  }
+
+  std::set<profile_id_t> toggled;
+  if (client_registry.update_profile_allocs(std::move(allocs), &toggled)) {
+    // refresh the ClientInfo pointers cached by the queue
+    scheduler.update_client_infos();
+    requeue_profile_items(toggled);
+    dout(10) << __func__ << " e" << osdmap.get_epoch()
+             << " updated pool client QoS params" << dendl;
+  }
+}
+
+void mClockScheduler::requeue_profile_items(
+  const std::set<profile_id_t> &toggled)
+{
+  if (toggled.empty()) {
+    return;
+  }
+  // Items of a toggled pool are all queued under the old key and none
+  // under the new one yet, so moving them in order keeps each client's
+  // ops to a PG in order across the two dmclock clients
+  std::list<OpSchedulerItem> moved;
+  scheduler.remove_by_req_filter(
+    [&](std::unique_ptr<OpSchedulerItem>&& r) {
+      if (r->get_scheduler_class() != op_scheduler_class::client ||
+	  !toggled.count(
+	    static_cast<profile_id_t>(r->get_ordering_token().pool()))) {
+	return false;
+      }
+      moved.push_back(std::move(*r));
+      return true;
+    }, false);
+  for (auto& item : moved) {
+    auto id = get_scheduler_id(item);
+    int cost = item.get_qos_cost();
+    scheduler.add_request(std::move(item), id, cost);
+  }
+  dout(10) << __func__ << " requeued " << moved.size() << " items" << dendl;
+}
+
 void mClockScheduler::dump(ceph::Formatter &f) const
 {
   // Display queue sizes
@@ -410,6 +592,7 @@ void mClockScheduler::dump(ceph::Formatter &f) const
   f.dump_int("client_count", scheduler.client_count());
   out << scheduler;
   f.dump_string("clients", out.str());
+  client_registry.dump_profiles(f);
   f.close_section();
 
   // Display sorted queues (res, wgt, lim)
@@ -461,6 +644,7 @@ void mClockScheduler::enqueue_front(OpSchedulerItem&& item)
 
 WorkItem mClockScheduler::dequeue()
 {
+  client_registry.refresh_profiles();
   if (!immediate.empty()) {
     WorkItem work_item{std::move(immediate.back())};
     immediate.pop_back();
@@ -15,8 +15,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <ostream>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "boost/variant.hpp"
@@ -116,12 +118,36 @@ class mClockScheduler : public OpScheduler, md_config_obs_t {
     crimson::dmclock::ClientInfo default_external_client_info = {1, 1, 1};
     std::map<client_profile_id_t,
 	     crimson::dmclock::ClientInfo> external_client_infos;
+    // Per-profile (pool) overrides of the default external client info.
+    // A zero allocation inherits the corresponding default value.
+    std::map<profile_id_t, ClientAllocs> profile_allocs;
+    std::map<profile_id_t,
+	     crimson::dmclock::ClientInfo> profile_client_infos;
+    // Set by the config observer when the defaults the profiles inherit
+    // from changed. The profile maps are only touched under the shard
+    // lock, so the recomputation is left to refresh_profiles().
+    std::atomic<bool> profiles_dirty = false;
+    void update_profile_client_infos();
     const crimson::dmclock::ClientInfo *get_external_client(
       const client_profile_id_t &client) const;
   public:
     void update_from_config(const ConfigProxy &conf);
+    // Recompute the profile client infos if update_from_config() ran
+    // since the last call
+    void refresh_profiles();
+    // Returns true if any allocation changed. Profiles that were added
+    // or removed are returned in *toggled, the queue must then refresh
+    // the ClientInfo pointers it has cached and requeue their items.
+    bool update_profile_allocs(std::map<profile_id_t, ClientAllocs> &&allocs,
+			       std::set<profile_id_t> *toggled);
+    bool has_profile(profile_id_t profile_id) const {
+      return profile_allocs.count(profile_id) > 0;
+    }
+    // Returns true if a profile refers to a pool the osdmap no longer has
+    bool has_stale_profile(const OSDMap &osdmap) const;
     const crimson::dmclock::ClientInfo *get_info(
       const scheduler_id_t &id) const;
+    void dump_profiles(ceph::Formatter &f) const;
   } client_registry;
 
   using mclock_queue_t = crimson::dmclock::PullPriorityQueue<
@@ -132,13 +158,31 @@ class mClockScheduler : public OpScheduler, md_config_obs_t {
     2>;
   mclock_queue_t scheduler;
   std::list<OpSchedulerItem> immediate;
-
-  static scheduler_id_t get_scheduler_id(const OpSchedulerItem &item) {
+  // Epoch of the last osdmap whose pool QoS options were applied
+  epoch_t pool_qos_epoch = 0;
+
+  // Move the queued client items of pools that gained or lost a profile
+  // to the dmclock client they are now keyed by
+  void requeue_profile_items(const std::set<profile_id_t> &toggled);
+
+  scheduler_id_t get_scheduler_id(const OpSchedulerItem &item) const {
+    // Client ops in a pool with QoS settings are tagged with that pool.
+    // All other client ops share profile 0 so that, with nothing
+    // configured, each client keeps a single queue.
+    auto class_id = item.get_scheduler_class();
+    profile_id_t profile_id = 0;
+    if (class_id == op_scheduler_class::client) {
+      auto pool_profile = static_cast<profile_id_t>(
+	item.get_ordering_token().pool());
+      if (client_registry.has_profile(pool_profile)) {
+	profile_id = pool_profile;
+      }
+    }
     return scheduler_id_t{
-      item.get_scheduler_class(),
+      class_id,
 	client_profile_id_t{
 	item.get_owner(),
-	  0
+	  profile_id
 	  }
     };
   }
@@ -207,6 +251,15 @@ public:
   // Update data associated with the modified mclock config key(s)
   void update_configuration() final;
 
+  // Apply the mclock_client_{res,wgt,lim} pool options
+  void update_pool_qos(const OSDMap &osdmap) final;
+
+  // Return the QoS parameters the queue applies to the item
+  const crimson::dmclock::ClientInfo *get_client_info(
+    const OpSchedulerItem &item) const {
+    return client_registry.get_info(get_scheduler_id(item));
+  }
+
   const char** get_tracked_conf_keys() const final;
   void handle_conf_change(const ConfigProxy& conf,
 			  const std::set<std::string> &changed) final;
@@ -115,6 +115,26 @@ std::optional<double> ScrubQueue::update_load_average()
   return std::nullopt;
 }
 
+void ScrubQueue::update_client_io_stats(uint64_t op_lat_sum_ns,
+					uint64_t op_count)
+{
+  if (op_count < last_op_count || op_lat_sum_ns < last_op_lat_sum_ns) {
+    // the counters were reset
+    recent_client_lat_ms = 0.0;
+  } else if (op_count > last_op_count) {
+    recent_client_lat_ms =
+      static_cast<double>(op_lat_sum_ns - last_op_lat_sum_ns) /
+      (op_count - last_op_count) / 1'000'000.0;
+  } else {
+    // no client ops in the last interval
+    recent_client_lat_ms = 0.0;
+  }
+  last_op_lat_sum_ns = op_lat_sum_ns;
+  last_op_count = op_count;
+  dout(17) << "heartbeat: recent client op latency " << recent_client_lat_ms
+	   << "ms" << dendl;
+}
+
 /*
  * Modify the scrub job state:
  * - if 'registered' (as expected): mark as 'unregistering'. The job will be
@@ -349,7 +369,9 @@ Scrub::schedule_result_t ScrubQueue::select_pg_and_scrub(
 
   preconds.time_permit = scrub_time_permit(now_is);
   preconds.load_is_low = scrub_load_below_threshold();
-  preconds.only_deadlined = !preconds.time_permit || !preconds.load_is_low;
+  preconds.client_io_permit = scrub_client_io_permit();
+  preconds.only_deadlined = !preconds.time_permit || !preconds.load_is_low ||
+			    !preconds.client_io_permit;
 
   //  create a list of candidates (copying, as otherwise creating a deadlock):
   //  - possibly restore penalized
@@ -470,7 +492,8 @@ Scrub::schedule_result_t ScrubQueue::select_from_group(
     if (preconds.only_deadlined && (candidate->schedule.deadline.is_zero() ||
 				    candidate->schedule.deadline >= now_is)) {
       dout(15) << " not scheduling scrub for " << candidate->pgid << " due to "
-	       << (preconds.time_permit ? "high load" : "time not permitting")
+	       << (!preconds.time_permit ? "time not permitting" :
+		   !preconds.load_is_low ? "high load" : "client latency")
 	       << dendl;
       continue;
     }
@@ -562,12 +585,13 @@ double ScrubQueue::scrub_sleep_time(bool must_scrub) const
 {
   double regular_sleep_period = conf()->osd_scrub_sleep;
 
-  if (must_scrub || scrub_time_permit(time_now())) {
+  if (must_scrub ||
+      (scrub_time_permit(time_now()) && scrub_client_io_permit())) {
     return regular_sleep_period;
   }
 
   // relevant if scrubbing started during allowed time, but continued into
-  // forbidden hours
+  // forbidden hours, or if client latency has since gone up
   double extended_sleep = conf()->osd_scrub_extended_sleep;
   dout(20) << "w/ extended sleep (" << extended_sleep << ")" << dendl;
   return std::max(extended_sleep, regular_sleep_period);
@@ -605,6 +629,18 @@ bool ScrubQueue::scrub_load_below_threshold() const
   return false;
 }
 
+bool ScrubQueue::scrub_client_io_permit() const
+{
+  const auto threshold =
+    conf().get_val<double>("osd_scrub_client_latency_threshold");
+  if (threshold <= 0.0 || recent_client_lat_ms < threshold) {
+    return true;
+  }
+
+  dout(20) << "client op latency " << recent_client_lat_ms << "ms >= max "
+	   << threshold << "ms = no" << dendl;
+  return false;
+}
 
 // note: called with jobs_lock held
 void ScrubQueue::scan_penalized(bool forgive_all, utime_t time_now)
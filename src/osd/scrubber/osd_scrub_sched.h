@@ -89,8 +89,10 @@ ScrubQueue interfaces (main functions):
 <2> - environment conditions:
 
   - update_loadavg()
+  - update_client_io_stats()
 
   - scrub_load_below_threshold()
+  - scrub_client_io_permit()
   - scrub_time_permit()
 
 <3> - scheduling scrubs:
@@ -406,6 +408,15 @@ class ScrubQueue {
    */
   [[nodiscard]] std::optional<double> update_load_average();
 
+  /**
+   *  called every heartbeat with the OSD's (cumulative) client op latency
+   *  counters, to track the client latency over the last interval
+   *
+   *  @param op_lat_sum_ns: the sum of all client op latencies
+   *  @param op_count: the number of client ops
+   */
+  void update_client_io_stats(uint64_t op_lat_sum_ns, uint64_t op_count);
+
  private:
   CephContext* cct;
   Scrub::ScrubSchedListener& osd_service;
@@ -433,6 +444,12 @@ class ScrubQueue {
 
   double daily_loadavg{0.0};
 
+  /// client op latency counters at the previous heartbeat
+  uint64_t last_op_lat_sum_ns{0};
+  uint64_t last_op_count{0};
+  /// average client op latency (ms) over the last heartbeat interval
+  double recent_client_lat_ms{0.0};
+
   static inline constexpr auto registered_job = [](const auto& jobref) -> bool {
     return jobref->state == qu_state_t::registered;
   };
@@ -487,6 +504,7 @@ class ScrubQueue {
   std::atomic_bool a_pg_is_reserving{false};
 
   [[nodiscard]] bool scrub_load_below_threshold() const;
+  [[nodiscard]] bool scrub_client_io_permit() const;
   [[nodiscard]] bool scrub_time_permit(utime_t now) const;
 
   /**
@@ -45,6 +45,7 @@ using act_token_t = uint32_t;
 struct ScrubPreconds {
   bool allow_requested_repair_only{false};
   bool load_is_low{true};
+  bool client_io_permit{true};
   bool time_permit{true};
   bool only_deadlined{false};
 };
@@ -564,6 +564,14 @@ void Journaler::_finish_flush(int r, uint64_t start, ceph::real_time stamp)
     }
     finish_contexts(cct, ls);
   }
+
+  // issue whatever accumulated while we were waiting on this write
+  if (flush_coalesced && pending_safe.empty()) {
+    flush_coalesced = false;
+    ldout(cct, 10) << "_finish_flush issuing coalesced flush of "
+		   << (write_pos - flush_pos) << " bytes" << dendl;
+    _do_flush();
+  }
 }
 
 
@@ -759,7 +767,14 @@ void Journaler::_flush(C_OnFinisher *onsafe)
     if (onsafe) {
       onsafe->complete(0);
     }
+  } else if (_should_coalesce_flush()) {
+    ldout(cct, 10) << "_flush coalescing " << flush_pos << "~"
+		   << (write_pos - flush_pos) << " behind in-flight writes"
+		   << dendl;
+    flush_coalesced = true;
+    _wait_for_flush(onsafe);
   } else {
+    flush_coalesced = false;
     _do_flush();
     _wait_for_flush(onsafe);
   }
@@ -770,6 +785,24 @@ void Journaler::_flush(C_OnFinisher *onsafe)
   }
 }
 
+/*
+ * Hold back a small flush while an earlier write is still in flight so
+ * that back-to-back appends go out as one write instead of many small
+ * ones.  The held data is written when the in-flight writes commit (see
+ * _finish_flush), and each waiter still completes at its own entry
+ * boundary.
+ */
+bool Journaler::_should_coalesce_flush() const
+{
+  uint64_t max = cct->_conf.get_val<Option::size_t>(
+    "journaler_flush_coalesce_bytes");
+  if (!max || pending_safe.empty())
+    return false;
+  if (waiting_for_zero_pos)
+    return false;
+  return write_pos - flush_pos < max;
+}
+
 bool Journaler::_write_head_needed()
 {
   return last_wrote_head + seconds(cct->_conf.get_val<int64_t>("journaler_write_head_interval"))
@@ -257,8 +257,13 @@ private:
   int state;
   int error;
 
+  // a flush() held back while an earlier write was in flight; issued
+  // from _finish_flush() so that small appends share one write
+  bool flush_coalesced;
+
   void _write_head(Context *oncommit=NULL);
   void _wait_for_flush(Context *onsafe);
+  bool _should_coalesce_flush() const;
   void _trim();
 
   // header
@@ -404,7 +409,7 @@ public:
     magic(mag),
     objecter(obj), filer(objecter, f), logger(l), logger_key_lat(lkey),
     delay_flush_event(0),
-    state(STATE_UNDEF), error(0),
+    state(STATE_UNDEF), error(0), flush_coalesced(false),
     prezeroing_pos(0), prezero_pos(0), write_pos(0), flush_pos(0),
     safe_pos(0), next_safe_pos(0),
     write_buf_throttle(cct, "write_buf_throttle", UINT_MAX - (UINT_MAX >> 3)),
@@ -431,6 +436,7 @@ public:
     delay_flush_event = NULL;
     state = STATE_UNDEF;
     error = 0;
+    flush_coalesced = false;
     prezeroing_pos = 0;
     prezero_pos = 0;
     write_pos = 0;
@@ -1276,7 +1276,8 @@ void ObjectCacher::bh_write_commit(int64_t poolid, sobject_t oid,
     finish_contexts(cct, ls, r);
 }
 
-void ObjectCacher::flush(ZTracer::Trace *trace, loff_t amount)
+void ObjectCacher::flush(ZTracer::Trace *trace, loff_t amount,
+			 int *max_count)
 {
   ceph_assert(trace != nullptr);
   ceph_assert(ceph_mutex_is_locked(lock));
@@ -1292,16 +1293,20 @@ void ObjectCacher::flush(ZTracer::Trace *trace, loff_t amount)
    */
   int64_t left = amount;
   while (amount == 0 || left > 0) {
+    if (max_count && *max_count <= 0)
+      break;
     BufferHead *bh = static_cast<BufferHead*>(
       bh_lru_dirty.lru_get_next_expire());
     if (!bh) break;
     if (bh->last_write > cutoff) break;
 
     if (scattered_write) {
-      bh_write_adjacencies(bh, cutoff, amount > 0 ? &left : NULL, NULL);
+      bh_write_adjacencies(bh, cutoff, amount > 0 ? &left : NULL, max_count);
     } else {
       left -= bh->length();
       bh_write(bh, *trace);
+      if (max_count)
+	--*max_count;
     }
   }
 }
@@ -1967,7 +1972,15 @@ void ObjectCacher::flusher_entry()
       ldout(cct, 10) << "flusher " << get_stat_dirty() << " dirty + "
 		     << get_stat_dirty_waiting() << " dirty_waiting > target "
 		     << target_dirty << ", flushing some dirty bhs" << dendl;
-      flush(&trace, actual - target_dirty);
+      int max = MAX_FLUSH_UNDER_LOCK;
+      flush(&trace, actual - target_dirty, &max);
+      if (max <= 0) {
+	// more to do; let readers and writers in before the next batch
+	trace.event("backoff");
+	l.unlock();
+	l.lock();
+	continue;
+      }
     } else {
       // check tail of lru for old dirty items
       ceph::real_time cutoff = ceph::real_clock::now();
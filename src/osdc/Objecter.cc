@@ -179,6 +179,9 @@ enum {
   l_osdc_osdop_omap_rd,
   l_osdc_osdop_omap_del,
 
+  l_osdc_op_hedge,
+  l_osdc_op_hedge_won,
+
   l_osdc_last,
 };
 
@@ -219,6 +222,9 @@ const char** Objecter::get_tracked_conf_keys() const
     "crush_location",
     "rados_mon_op_timeout",
     "rados_osd_op_timeout",
+    "objecter_hedge_reads",
+    "objecter_hedge_read_percentile",
+    "objecter_hedge_read_min_delay",
     NULL
   };
   return config_keys;
@@ -237,6 +243,16 @@ void Objecter::handle_conf_change(const ConfigProxy& conf,
   if (changed.count("rados_osd_op_timeout")) {
     osd_timeout = conf.get_val<std::chrono::seconds>("rados_osd_op_timeout");
   }
+  if (changed.count("objecter_hedge_reads") ||
+      changed.count("objecter_hedge_read_percentile") ||
+      changed.count("objecter_hedge_read_min_delay")) {
+    unique_lock wl(rwlock);
+    hedge_reads = conf.get_val<bool>("objecter_hedge_reads");
+    hedge_read_percentile =
+      conf.get_val<double>("objecter_hedge_read_percentile");
+    hedge_read_min_delay = conf.get_val<std::chrono::milliseconds>(
+      "objecter_hedge_read_min_delay");
+  }
 }
 
 void Objecter::update_crush_location()
@@ -377,6 +393,11 @@ void Objecter::init()
     pcb.add_u64_counter(l_osdc_osdop_omap_del, "omap_del",
 			"OSD OMAP delete operations");
 
+    pcb.add_u64_counter(l_osdc_op_hedge, "op_hedge",
+			"Reads also sent to a replica after a slow primary");
+    pcb.add_u64_counter(l_osdc_op_hedge_won, "op_hedge_won",
+			"Hedged reads completed by the replica");
+
     logger = pcb.create_perf_counters();
     cct->get_perfcounters_collection()->add(logger);
   }
@@ -2267,11 +2288,14 @@ void Objecter::resend_mon_ops()
 
 void Objecter::op_submit(Op *op, ceph_tid_t *ptid, int *ctx_budget)
 {
-  shunique_lock rl(rwlock, ceph::acquire_shared);
   ceph_tid_t tid = 0;
   if (!ptid)
     ptid = &tid;
   op->trace.event("op submit");
+  // take the budget before rwlock.  a submitter that blocks on the
+  // throttle then neither holds the lock meanwhile nor has to drop and
+  // retake it (bouncing its cache line off every other submitter)
+  shunique_lock rl(rwlock, std::defer_lock);
   _op_submit_with_budget(op, rl, ptid, ctx_budget);
 }
 
@@ -2296,6 +2320,9 @@ void Objecter::_op_submit_with_budget(Op *op,
       *ctx_budget = op_budget;
     }
   }
+  if (!sul) {
+    sul.lock_shared();
+  }
 
   if (osd_timeout > timespan(0)) {
     if (op->tid == 0)
@@ -3040,6 +3067,7 @@ void Objecter::_session_op_remove(OSDSession *from, Op *op)
     num_homeless_ops--;
   }
 
+  _forget_hedge(op);
   from->ops.erase(op->tid);
   put_session(from);
   op->session = NULL;
@@ -3186,11 +3214,10 @@ void Objecter::_finish_op(Op *op, int r)
   op->put();
 }
 
-Objecter::MOSDOp *Objecter::_prepare_osd_op(Op *op)
+Objecter::MOSDOp *Objecter::_build_osd_op(Op *op, int flags, int attempt)
 {
   // rwlock is locked
 
-  int flags = op->target.flags;
   flags |= CEPH_OSD_FLAG_KNOWN_REDIR;
   flags |= CEPH_OSD_FLAG_SUPPORTSPOOLEIO;
 
@@ -3201,9 +3228,6 @@ Objecter::MOSDOp *Objecter::_prepare_osd_op(Op *op)
   if (!honor_pool_full)
     flags |= CEPH_OSD_FLAG_FULL_FORCE;
 
-  op->target.paused = false;
-  op->stamp = ceph::coarse_mono_clock::now();
-
   hobject_t hobj = op->target.get_hobj();
   auto m = new MOSDOp(client_inc, op->tid,
 		      hobj, op->target.actual_pgid,
@@ -3216,11 +3240,7 @@ Objecter::MOSDOp *Objecter::_prepare_osd_op(Op *op)
 
   m->ops = op->ops;
   m->set_mtime(op->mtime);
-  m->set_retry_attempt(op->attempts++);
-
-  if (!op->trace.valid() && cct->_conf->osdc_blkin_trace_all) {
-    op->trace.init("op", &trace_endpoint);
-  }
+  m->set_retry_attempt(attempt);
 
   if (op->priority)
     m->set_priority(op->priority);
@@ -3231,6 +3251,22 @@ Objecter::MOSDOp *Objecter::_prepare_osd_op(Op *op)
     m->set_reqid(op->reqid);
   }
 
+  return m;
+}
+
+Objecter::MOSDOp *Objecter::_prepare_osd_op(Op *op)
+{
+  // rwlock is locked
+
+  op->target.paused = false;
+  op->stamp = ceph::coarse_mono_clock::now();
+
+  MOSDOp *m = _build_osd_op(op, op->target.flags, op->attempts++);
+
+  if (!op->trace.valid() && cct->_conf->osdc_blkin_trace_all) {
+    op->trace.init("op", &trace_endpoint);
+  }
+
   logger->inc(l_osdc_op_send);
   ssize_t sum = 0;
   for (unsigned i = 0; i < m->ops.size(); i++) {
@@ -3241,33 +3277,45 @@ Objecter::MOSDOp *Objecter::_prepare_osd_op(Op *op)
   return m;
 }
 
+const Objecter::OSDBackoff *Objecter::_find_backoff(OSDSession *s, Op *op)
+{
+  // s->lock is locked
+
+  auto p = s->backoffs.find(op->target.actual_pgid);
+  if (p == s->backoffs.end()) {
+    return nullptr;
+  }
+  hobject_t hoid = op->target.get_hobj();
+  auto q = p->second.lower_bound(hoid);
+  if (q != p->second.begin()) {
+    --q;
+    if (hoid >= q->second.end) {
+      ++q;
+    }
+  }
+  if (q == p->second.end()) {
+    return nullptr;
+  }
+  ldout(cct, 20) << __func__ << " ? " << q->first << " [" << q->second.begin
+		 << "," << q->second.end << ")" << dendl;
+  int r = cmp(hoid, q->second.begin);
+  if (r == 0 || (r > 0 && hoid < q->second.end)) {
+    return &q->second;
+  }
+  return nullptr;
+}
+
 void Objecter::_send_op(Op *op)
 {
   // rwlock is locked
   // op->session->lock is locked
 
   // backoff?
-  auto p = op->session->backoffs.find(op->target.actual_pgid);
-  if (p != op->session->backoffs.end()) {
-    hobject_t hoid = op->target.get_hobj();
-    auto q = p->second.lower_bound(hoid);
-    if (q != p->second.begin()) {
-      --q;
-      if (hoid >= q->second.end) {
-	++q;
-      }
-    }
-    if (q != p->second.end()) {
-      ldout(cct, 20) << __func__ << " ? " << q->first << " [" << q->second.begin
-		     << "," << q->second.end << ")" << dendl;
-      int r = cmp(hoid, q->second.begin);
-      if (r == 0 || (r > 0 && hoid < q->second.end)) {
-	ldout(cct, 10) << __func__ << " backoff " << op->target.actual_pgid
-		       << " id " << q->second.id << " on " << hoid
-		       << ", queuing " << op << " tid " << op->tid << dendl;
-	return;
-      }
-    }
+  if (auto b = _find_backoff(op->session, op); b) {
+    ldout(cct, 10) << __func__ << " backoff " << op->target.actual_pgid
+		   << " id " << b->id << " on " << op->target.get_hobj()
+		   << ", queuing " << op << " tid " << op->tid << dendl;
+    return;
   }
 
   ceph_assert(op->tid > 0);
@@ -3312,6 +3360,198 @@ void Objecter::_send_op(Op *op)
     m->trace.init("op msg", nullptr, &op->trace);
   }
   op->session->con->send_message(m);
+
+  _arm_hedge(op);
+}
+
+bool Objecter::_hedge_eligible(Op *op)
+{
+  // rwlock is locked
+  // op->session->lock is locked
+
+  if (!hedge_reads || op->session->is_homeless() || op->hedge_osd >= 0)
+    return false;
+  if (op->session->hedge_delay == ceph::timespan::zero())
+    return false;  // no latency history for this osd yet
+  if (!op->should_resend)
+    return false;  // linger registrations and pings
+  int flags = op->target.flags;
+  if (!(flags & CEPH_OSD_FLAG_READ) || (flags & CEPH_OSD_FLAG_WRITE) ||
+      (flags & (CEPH_OSD_FLAG_BALANCE_READS | CEPH_OSD_FLAG_LOCALIZE_READS)) ||
+      op->target.used_replica || op->target.acting.size() < 2)
+    return false;
+  if (!is_hedgeable_read(op->ops))
+    return false;
+  const pg_pool_t *pi = osdmap->get_pg_pool(op->target.actual_pgid.pool());
+  return pi && pi->is_replicated();
+}
+
+bool Objecter::is_hedgeable_read(const bc::small_vector_base<OSDOp>& ops)
+{
+  if (ops.empty())
+    return false;
+  for (auto& o : ops) {
+    switch (o.op.op) {
+    case CEPH_OSD_OP_READ:
+    case CEPH_OSD_OP_SPARSE_READ:
+    case CEPH_OSD_OP_SYNC_READ:
+    case CEPH_OSD_OP_STAT:
+    case CEPH_OSD_OP_CHECKSUM:
+    case CEPH_OSD_OP_CMPEXT:
+    case CEPH_OSD_OP_ASSERT_VER:
+    case CEPH_OSD_OP_GETXATTR:
+    case CEPH_OSD_OP_GETXATTRS:
+    case CEPH_OSD_OP_CMPXATTR:
+    case CEPH_OSD_OP_OMAPGETKEYS:
+    case CEPH_OSD_OP_OMAPGETVALS:
+    case CEPH_OSD_OP_OMAPGETHEADER:
+    case CEPH_OSD_OP_OMAPGETVALSBYKEYS:
+    case CEPH_OSD_OP_OMAP_CMP:
+      break;
+    default:
+      // watch/notify, class methods and the like may have side effects
+      // or depend on state that only the primary has
+      return false;
+    }
+  }
+  return true;
+}
+
+void Objecter::_arm_hedge(Op *op)
+{
+  // rwlock is locked
+  // op->session->lock is locked
+
+  if (op->onhedge) {
+    timer.cancel_event(op->onhedge);
+    op->onhedge = 0;
+  }
+  if (!_hedge_eligible(op))
+    return;
+  auto delay = std::max(op->session->hedge_delay, hedge_read_min_delay);
+  op->onhedge = timer.add_event(delay,
+				[this, tid = op->tid, osd = op->session->osd]() {
+				  _hedge_read(tid, osd); });
+}
+
+void Objecter::_hedge_read(ceph_tid_t tid, int osd)
+{
+  shunique_lock sul(rwlock, ceph::acquire_shared);
+  if (!initialized)
+    return;
+  auto siter = osd_sessions.find(osd);
+  if (siter == osd_sessions.end())
+    return;
+  OSDSession *s = siter->second;
+  unique_lock sl(s->lock);
+  auto p = s->ops.find(tid);
+  if (p == s->ops.end())
+    return;
+  Op *op = p->second;
+  op->onhedge = 0;
+  if (op->hedge_osd >= 0 || op->target.paused)
+    return;
+
+  // only replicas we already have a session with and that are not
+  // backing off the pg, so we never block here
+  OSDSession *rs = nullptr;
+  for (auto r : op->target.acting) {
+    if (r < 0 || r == osd)
+      continue;
+    auto q = osd_sessions.find(r);
+    if (q == osd_sessions.end() || !q->second->con)
+      continue;
+    // s->lock is held, so don't wait for a second session lock
+    std::shared_lock rl(q->second->lock, std::try_to_lock);
+    if (rl.owns_lock() && !_find_backoff(q->second, op)) {
+      rs = q->second;
+      break;
+    }
+  }
+  if (!rs) {
+    ldout(cct, 20) << __func__ << " " << tid << " no usable replica session"
+		   << dendl;
+    return;
+  }
+
+  // replicas only serve reads flagged as balanced.  the message carries
+  // the current attempt number, and the op keeps its send stamp, so that
+  // whichever reply comes first is accepted as the answer to this
+  // attempt.  this is not a new send of the op, so leave the send
+  // counters alone.
+  MOSDOp *m = _build_osd_op(
+    op, op->target.flags | CEPH_OSD_FLAG_BALANCE_READS, op->attempts - 1);
+
+  {
+    std::lock_guard hl(hedge_lock);
+    hedged_reads[tid] = osd;
+  }
+  op->hedge_osd = rs->osd;
+  logger->inc(l_osdc_op_hedge);
+  ldout(cct, 10) << __func__ << " " << tid << " slow on osd." << osd
+		 << ", also reading from osd." << rs->osd << dendl;
+  rs->con->send_message(m);
+}
+
+void Objecter::_forget_hedge(Op *op)
+{
+  // op->session->lock is locked
+
+  if (op->onhedge) {
+    timer.cancel_event(op->onhedge);
+    op->onhedge = 0;
+  }
+  if (op->hedge_osd >= 0) {
+    std::lock_guard hl(hedge_lock);
+    hedged_reads.erase(op->tid);
+    op->hedge_osd = -1;
+    ldout(cct, 20) << __func__ << " " << op->tid << ", "
+		   << hedged_reads.size() << " hedged reads left" << dendl;
+  }
+}
+
+Objecter::OSDSession *Objecter::_hedged_read_session(ceph_tid_t tid,
+						     OSDSession *s)
+{
+  // rwlock is locked
+
+  int osd;
+  {
+    std::lock_guard hl(hedge_lock);
+    auto p = hedged_reads.find(tid);
+    if (p == hedged_reads.end() || p->second == s->osd)
+      return nullptr;
+    osd = p->second;
+  }
+  auto q = osd_sessions.find(osd);
+  return q == osd_sessions.end() ? nullptr : q->second;
+}
+
+void Objecter::_record_read_latency(OSDSession *s, ceph::timespan lat)
+{
+  // s->lock is locked unique
+
+  static constexpr unsigned max_samples = 128;
+  static constexpr unsigned update_every = 32;
+
+  uint32_t us = std::min<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(lat).count(),
+    std::numeric_limits<uint32_t>::max());
+  if (s->read_lat_us.size() < max_samples) {
+    s->read_lat_us.push_back(us);
+  } else {
+    s->read_lat_us[s->read_lat_count % max_samples] = us;
+  }
+  if (++s->read_lat_count % update_every)
+    return;
+
+  std::vector<uint32_t> v = s->read_lat_us;
+  auto nth = v.begin() + static_cast<std::ptrdiff_t>(
+    (v.size() - 1) * hedge_read_percentile.load());
+  std::nth_element(v.begin(), nth, v.end());
+  s->hedge_delay = std::chrono::microseconds(*nth);
+  ldout(cct, 20) << __func__ << " osd." << s->osd << " hedge delay "
+		 << s->hedge_delay << dendl;
 }
 
 int Objecter::calc_op_budget(const bc::small_vector_base<OSDOp>& ops)
@@ -3336,11 +3576,16 @@ void Objecter::_throttle_op(Op *op,
 			    shunique_lock<ceph::shared_mutex>& sul,
 			    int op_budget)
 {
-  ceph_assert(sul && sul.mutex() == &rwlock);
+  ceph_assert(sul.mutex() == &rwlock);
   bool locked_for_write = sul.owns_lock();
 
   if (!op_budget)
     op_budget = calc_op_budget(op->ops);
+  if (!sul) {
+    op_throttle_bytes.get(op_budget);
+    op_throttle_ops.get(1);
+    return;
+  }
   if (!op_throttle_bytes.get_or_fail(op_budget)) { //couldn't take right now
     sul.unlock();
     op_throttle_bytes.get(op_budget);
@@ -3390,6 +3635,17 @@ void Objecter::handle_osd_op_reply(MOSDOpReply *m)
   unique_lock sl(s->lock);
 
   map<ceph_tid_t, Op *>::iterator iter = s->ops.find(tid);
+  bool hedge_reply = false;
+  if (iter == s->ops.end()) {
+    // a replica answering a hedged read; the op lives on the primary
+    if (auto ps = _hedged_read_session(tid, s); ps) {
+      sl.unlock();
+      s = ps;
+      sl = unique_lock(s->lock);
+      iter = s->ops.find(tid);
+      hedge_reply = (iter != s->ops.end());
+    }
+  }
   if (iter == s->ops.end()) {
     ldout(cct, 7) << "handle_osd_op_reply " << tid
 		  << (m->is_ondisk() ? " ondisk" : (m->is_onnvram() ?
@@ -3445,6 +3701,15 @@ void Objecter::handle_osd_op_reply(MOSDOpReply *m)
 
   int rc = m->get_result();
 
+  if (hedge_reply && (rc == -EAGAIN || m->is_redirect_reply())) {
+    // the replica can't serve it; keep waiting for the primary
+    ldout(cct, 7) << " hedged read " << tid << " refused by replica, r="
+		  << rc << dendl;
+    sl.unlock();
+    m->put();
+    return;
+  }
+
   if (m->is_redirect_reply()) {
     ldout(cct, 5) << " got redirect reply; redirecting" << dendl;
     if (op->has_completion())
@@ -3568,6 +3833,17 @@ void Objecter::handle_osd_op_reply(MOSDOpReply *m)
   }
   logger->inc(l_osdc_op_reply);
   logger->tinc(l_osdc_op_latency, ceph::coarse_mono_time::clock::now() - op->stamp);
+  if (hedge_reply) {
+    ldout(cct, 10) << " hedged read " << tid << " answered by osd."
+		   << op->hedge_osd << dendl;
+    logger->inc(l_osdc_op_hedge_won);
+    // s is the primary, which has not answered yet: its latency is at
+    // least this long.  record that, or a primary that only ever loses
+    // to the hedge would keep its old (short) delay forever.
+    _record_read_latency(s, ceph::coarse_mono_clock::now() - op->stamp);
+  } else if (hedge_reads && (op->target.flags & CEPH_OSD_FLAG_READ)) {
+    _record_read_latency(s, ceph::coarse_mono_clock::now() - op->stamp);
+  }
   logger->set(l_osdc_op_inflight, num_in_flight);
 
   /* get it before we call _finish_op() */
@@ -5008,6 +5284,11 @@ Objecter::Objecter(CephContext *cct,
 {
   mon_timeout = cct->_conf.get_val<std::chrono::seconds>("rados_mon_op_timeout");
   osd_timeout = cct->_conf.get_val<std::chrono::seconds>("rados_osd_op_timeout");
+  hedge_reads = cct->_conf.get_val<bool>("objecter_hedge_reads");
+  hedge_read_percentile =
+    cct->_conf.get_val<double>("objecter_hedge_read_percentile");
+  hedge_read_min_delay = cct->_conf.get_val<std::chrono::milliseconds>(
+    "objecter_hedge_read_min_delay");
 }
 
 Objecter::~Objecter()
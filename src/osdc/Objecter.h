@@ -1931,6 +1931,8 @@ public:
     std::variant<std::unique_ptr<OpComp>, fu2::unique_function<OpSig>,
 		 Context*> onfinish;
     uint64_t ontimeout = 0;
+    uint64_t onhedge = 0;  ///< timer event that hedges a slow read
+    int hedge_osd = -1;    ///< replica a hedged read was also sent to
 
     ceph_tid_t tid = 0;
     int attempts = 0;
@@ -2398,6 +2400,12 @@ public:
     int num_locks;
     std::unique_ptr<std::mutex[]> completion_locks;
 
+    // recent read latencies from this osd (usec) and the hedge delay
+    // derived from them, both protected by lock
+    std::vector<uint32_t> read_lat_us;
+    uint64_t read_lat_count = 0;
+    ceph::timespan hedge_delay = ceph::timespan::zero();
+
     OSDSession(CephContext *cct, int o) :
       osd(o), incarnation(0), con(NULL),
       num_locks(cct->_conf->objecter_completion_locks_per_session),
@@ -2454,7 +2462,25 @@ public:
   ceph::timespan mon_timeout;
   ceph::timespan osd_timeout;
 
+  // hedged reads: a replicated-pool read that is slower than the
+  // primary's recent percentile is also sent to a replica, and the
+  // first reply wins
+  std::atomic<bool> hedge_reads;
+  std::atomic<double> hedge_read_percentile;
+  ceph::timespan hedge_read_min_delay;  // protected by rwlock
+  std::mutex hedge_lock;
+  std::map<ceph_tid_t, int> hedged_reads;  ///< tid -> primary osd
+
+  bool _hedge_eligible(Op *op);
+  void _arm_hedge(Op *op);
+  void _hedge_read(ceph_tid_t tid, int osd);
+  void _forget_hedge(Op *op);
+  OSDSession *_hedged_read_session(ceph_tid_t tid, OSDSession *s);
+  void _record_read_latency(OSDSession *s, ceph::timespan lat);
+
+  MOSDOp *_build_osd_op(Op *op, int flags, int attempt);
   MOSDOp *_prepare_osd_op(Op *op);
+  const OSDBackoff *_find_backoff(OSDSession *s, Op *op);
   void _send_op(Op *op);
   void _send_op_account(Op *op);
   void _cancel_linger_op(Op *op);
@@ -2558,8 +2584,9 @@ private:
   int calc_op_budget(const boost::container::small_vector_base<OSDOp>& ops);
   void _throttle_op(Op *op, ceph::shunique_lock<ceph::shared_mutex>& sul,
 		    int op_size = 0);
+  // sul may be unlocked, in which case we block on the throttle directly
   int _take_op_budget(Op *op, ceph::shunique_lock<ceph::shared_mutex>& sul) {
-    ceph_assert(sul && sul.mutex() == &rwlock);
+    ceph_assert(sul.mutex() == &rwlock);
     int op_budget = calc_op_budget(op->ops);
     if (keep_balanced_budget) {
       _throttle_op(op, sul, op_budget);
@@ -2720,6 +2747,10 @@ private:
   // public interface
 public:
   void op_submit(Op *op, ceph_tid_t *ptid = NULL, int *ctx_budget = NULL);
+  /// true if ops only read object data or metadata, so that sending them
+  /// to a second osd cannot have side effects
+  static bool is_hedgeable_read(
+    const boost::container::small_vector_base<OSDOp>& ops);
   bool is_active() {
     std::shared_lock l(rwlock);
     return !((!inflight_ops) && linger_ops.empty() &&
@@ -39,6 +39,17 @@ object_t format_oid(const char* object_format, uint64_t object_no) {
   return object_t(buf);
 }
 
+// make room for n more elements.  callers may append to the same vector
+// many times, so grow geometrically rather than to the exact size, which
+// would reallocate (and copy everything) on every call
+template <typename V>
+void reserve_for_append(V& v, size_t n) {
+  size_t want = v.size() + n;
+  if (want > v.capacity()) {
+    v.reserve(std::max<size_t>(want, 2 * v.capacity()));
+  }
+}
+
 struct OrderByObject {
   constexpr bool operator()(uint64_t object_no,
                             const striper::LightweightObjectExtent& rhs) const {
@@ -130,15 +141,16 @@ void Striper::file_to_extents(CephContext *cct, const char *object_format,
                   &lightweight_object_extents);
 
   // convert lightweight object extents to heavyweight version
-  extents.reserve(lightweight_object_extents.size());
+  auto oloc = OSDMap::file_to_object_locator(*layout);
+  reserve_for_append(extents, lightweight_object_extents.size());
   for (auto& lightweight_object_extent : lightweight_object_extents) {
     auto& object_extent = extents.emplace_back(
-      object_t(format_oid(object_format, lightweight_object_extent.object_no)),
+      format_oid(object_format, lightweight_object_extent.object_no),
       lightweight_object_extent.object_no,
       lightweight_object_extent.offset, lightweight_object_extent.length,
       lightweight_object_extent.truncate_size);
 
-    object_extent.oloc = OSDMap::file_to_object_locator(*layout);
+    object_extent.oloc = oloc;
     object_extent.buffer_extents.reserve(
       lightweight_object_extent.buffer_extents.size());
     object_extent.buffer_extents.insert(
@@ -161,6 +173,7 @@ void Striper::file_to_extents(
                   &lightweight_object_extents);
 
   // convert lightweight object extents to heavyweight version
+  auto oloc = OSDMap::file_to_object_locator(*layout);
   for (auto& lightweight_object_extent : lightweight_object_extents) {
     auto oid = format_oid(object_format, lightweight_object_extent.object_no);
     auto& object_extent = object_extents[oid].emplace_back(
@@ -168,7 +181,7 @@ void Striper::file_to_extents(
       lightweight_object_extent.offset, lightweight_object_extent.length,
       lightweight_object_extent.truncate_size);
 
-      object_extent.oloc = OSDMap::file_to_object_locator(*layout);
+      object_extent.oloc = oloc;
       object_extent.buffer_extents.reserve(
         lightweight_object_extent.buffer_extents.size());
       object_extent.buffer_extents.insert(
@@ -204,6 +217,12 @@ void Striper::file_to_extents(
 		 << object_size << " stripes_per_object " << stripes_per_object
 		 << dendl;
 
+  // one extent per object touched: at most one per stripe unit, and no
+  // more than stripe_count per object set spanned
+  reserve_for_append(*object_extents,
+    std::min<uint64_t>(len / su + 2,
+                       (len / layout->get_period() + 2) * stripe_count));
+
   uint64_t cur = offset;
   uint64_t left = len;
   while (left > 0) {
@@ -238,23 +257,38 @@ void Striper::file_to_extents(
 		   << dendl;
 
     striper::LightweightObjectExtent* ex = nullptr;
-    auto it = std::upper_bound(object_extents->begin(), object_extents->end(),
-                               objectno, OrderByObject());
-    striper::LightweightObjectExtents::reverse_iterator rev_it(it);
-    if (rev_it == object_extents->rend() ||
-        rev_it->object_no != objectno ||
-        rev_it->offset + rev_it->length != x_offset) {
-      // expect up to "stripe-width - 1" vector shifts in the worst-case
-      ex = &(*object_extents->emplace(
-        it, objectno, x_offset, x_len,
-        object_truncate_size(cct, layout, objectno, trunc_size)));
+    if (!object_extents->empty() &&
+        object_extents->back().object_no >= objectno) {
+      auto it = object_extents->end();
+      if (object_extents->back().object_no > objectno) {
+        it = std::upper_bound(object_extents->begin(), object_extents->end(),
+                              objectno, OrderByObject());
+      }
+      striper::LightweightObjectExtents::reverse_iterator rev_it(it);
+      if (rev_it == object_extents->rend() ||
+          rev_it->object_no != objectno ||
+          rev_it->offset + rev_it->length != x_offset) {
+        // expect up to "stripe-width - 1" vector shifts in the worst-case
+        ex = &(*object_extents->emplace(
+          it, objectno, x_offset, x_len,
+          object_truncate_size(cct, layout, objectno, trunc_size)));
         ldout(cct, 20) << " added new " << *ex << dendl;
-    } else {
-      ex = &(*rev_it);
-      ceph_assert(ex->offset + ex->length == x_offset);
+      } else {
+        ex = &(*rev_it);
+        ceph_assert(ex->offset + ex->length == x_offset);
 
-      ldout(cct, 20) << " adding in to " << *ex << dendl;
-      ex->length += x_len;
+        ldout(cct, 20) << " adding in to " << *ex << dendl;
+        ex->length += x_len;
+      }
+    } else {
+      // objects are visited in ascending order until the mapping wraps
+      // around a stripe, so this is the common case (and the only one
+      // for stripe_count 1): append without searching
+      object_extents->emplace_back(
+        objectno, x_offset, x_len,
+        object_truncate_size(cct, layout, objectno, trunc_size));
+      ex = &object_extents->back();
+      ldout(cct, 20) << " added new " << *ex << dendl;
     }
 
     ex->buffer_extents.emplace_back(cur - offset + buffer_offset, x_len);
@@ -393,7 +427,12 @@ void Striper::StripedReadResult::add_partial_result(
   for (auto p = buffer_extents.cbegin(); p != buffer_extents.cend(); ++p) {
     pair<bufferlist, uint64_t>& r = partial[p->first];
     size_t actual = std::min<uint64_t>(bl.length(), p->second);
-    bl.splice(0, actual, &r.first);
+    if (actual == bl.length()) {
+      // common case: the rest of bl belongs to this extent
+      r.first.claim_append(bl);
+    } else {
+      bl.splice(0, actual, &r.first);
+    }
     r.second = p->second;
     total_intended_len += r.second;
   }
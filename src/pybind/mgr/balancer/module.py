@@ -68,12 +68,17 @@ class Plan(object):
         self.compat_ws = {}
         self.inc = osdmap.new_incremental()
         self.pg_status = {}
+        self.predicted_bytes_moved = 0
+        self.predicted_shards_moved = 0
 
     def dump(self) -> str:
         return json.dumps(self.inc.dump(), indent=4, sort_keys=True)
 
     def show(self) -> str:
-        return 'upmap plan'
+        ls = ['upmap plan']
+        ls.append('# predicted data movement: %d pg shards, %d bytes' %
+                  (self.predicted_shards_moved, self.predicted_bytes_moved))
+        return '\n'.join(ls)
 
 
 class MsPlan(Plan):
@@ -1043,8 +1048,58 @@ class Module(MgrModule):
             return -errno.EALREADY, 'Unable to find further optimization, ' \
                                     'or pool(s) pg_num is decreasing, ' \
                                     'or distribution is already perfect'
+        self.predict_upmap_movement(plan)
         return 0, ''
 
+    def predict_upmap_movement(self, plan: Plan) -> None:
+        """
+        Estimate how much data executing an upmap plan would move.
+
+        Only pools touched by the plan are remapped.  Every up set
+        position that changes is one pg shard to be backfilled; its
+        size is estimated from the pool's average per-pg bytes (divided
+        by k for erasure coded pools), so that we don't need the full
+        pg_stats dump here.
+        """
+        inc_dump = plan.inc.dump()
+        pgids = [str(i['pgid']) for i in inc_dump.get('new_pg_upmap_items', [])]
+        pgids += [str(i) for i in inc_dump.get('old_pg_upmap_items', [])]
+        poolids = set(int(pgid.split('.')[0]) for pgid in pgids)
+        if not poolids:
+            return
+        pool_bytes = {
+            p['poolid']: p['stat_sum']['num_bytes']
+            for p in self.get('pool_stats').get('pool_stats', [])
+        }
+        ec_profiles = plan.osdmap_dump.get('erasure_code_profiles', {})
+        new_osdmap = plan.osdmap.apply_incremental(plan.inc)
+        shards = 0
+        total = 0
+        for p in plan.osdmap_dump.get('pools', []):
+            poolid = p['pool']
+            if poolid not in poolids or p['pg_num'] == 0:
+                continue
+            shard_bytes = pool_bytes.get(poolid, 0) // p['pg_num']
+            erasure = p['type'] == 3
+            if erasure:
+                profile = ec_profiles.get(p['erasure_code_profile'], {})
+                shard_bytes //= max(int(profile.get('k', 1)), 1)
+            before = plan.osdmap.map_pool_pgs_up(poolid)
+            after = new_osdmap.map_pool_pgs_up(poolid)
+            for pgid, old_up in before.items():
+                new_up = after.get(pgid, [])
+                if erasure:
+                    # shards are positional
+                    moved = sum(1 for a, b in zip(old_up, new_up) if a != b)
+                else:
+                    moved = len(set(new_up) - set(old_up))
+                shards += moved
+                total += moved * shard_bytes
+        plan.predicted_shards_moved = shards
+        plan.predicted_bytes_moved = total
+        self.log.info('plan %s predicted to move %d pg shards, %d bytes',
+                      plan.name, shards, total)
+
     def do_crush_compat(self, plan: MsPlan) -> Tuple[int, str]:
         self.log.info('do_crush_compat')
         max_iterations = cast(int, self.get_module_option('crush_compat_max_iterations'))
@@ -0,0 +1,80 @@
+# python unit test
+from tests import mock
+from balancer import module
+
+
+class Inc:
+    def __init__(self, dump):
+        self._dump = dump
+
+    def dump(self):
+        return self._dump
+
+
+class OSDMAP:
+    def __init__(self, pools, up, profiles=None):
+        self.pools = pools
+        self.up = up
+        self.profiles = profiles or {}
+        self.next = None
+
+    def dump(self):
+        return {'pools': self.pools,
+                'erasure_code_profiles': self.profiles}
+
+    def new_incremental(self):
+        return Inc({})
+
+    def apply_incremental(self, inc):
+        return self.next
+
+    def map_pool_pgs_up(self, poolid):
+        return {pgid: up for pgid, up in self.up.items()
+                if pgid.startswith('%d.' % poolid)}
+
+
+class TestPredictUpmapMovement(object):
+
+    def setup_method(self):
+        self.balancer = module.Module('balancer', 0, 0)
+
+    def predict(self, osdmap, inc_dump, pool_bytes):
+        plan = module.Plan('plan', module.Mode.upmap, osdmap, [])
+        plan.inc = Inc(inc_dump)
+        pool_stats = {'pool_stats': [
+            {'poolid': p, 'stat_sum': {'num_bytes': b}}
+            for p, b in pool_bytes.items()
+        ]}
+        with mock.patch.object(self.balancer, 'get', return_value=pool_stats):
+            self.balancer.predict_upmap_movement(plan)
+        return plan.predicted_shards_moved, plan.predicted_bytes_moved
+
+    def test_replicated(self):
+        pools = [{'pool': 1, 'pg_num': 4, 'type': 1},
+                 {'pool': 2, 'pg_num': 4, 'type': 1}]
+        before = OSDMAP(pools, {'1.0': [0, 1, 2], '1.1': [1, 2, 3],
+                                '2.0': [0, 1, 2]})
+        # 1.0 swaps osd.2 for osd.3; reordering 1.1 moves no data, and
+        # pool 2 is untouched by the plan
+        before.next = OSDMAP(pools, {'1.0': [0, 1, 3], '1.1': [3, 2, 1],
+                                     '2.0': [3, 4, 5]})
+        inc = {'new_pg_upmap_items': [
+            {'pgid': '1.0', 'mappings': [{'from': 2, 'to': 3}]}]}
+        assert self.predict(before, inc, {1: 4000, 2: 4000}) == (1, 1000)
+
+    def test_erasure(self):
+        pools = [{'pool': 1, 'pg_num': 2, 'type': 3,
+                  'erasure_code_profile': 'p'}]
+        profiles = {'p': {'k': '2', 'm': '1'}}
+        before = OSDMAP(pools, {'1.0': [0, 1, 2], '1.1': [1, 2, 3]},
+                        profiles)
+        # ec shards are positional, so reordering does move data
+        before.next = OSDMAP(pools, {'1.0': [0, 1, 2], '1.1': [2, 1, 3]},
+                             profiles)
+        inc = {'old_pg_upmap_items': ['1.1']}
+        assert self.predict(before, inc, {1: 8000}) == (2, 4000)
+
+    def test_empty_plan(self):
+        before = OSDMAP([{'pool': 1, 'pg_num': 4, 'type': 1}],
+                        {'1.0': [0, 1, 2]})
+        assert self.predict(before, {}, {1: 4000}) == (0, 0)
@@ -0,0 +1,116 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+/*
+ * Measure Objecter submit throughput with many threads.
+ *
+ * Every thread keeps a window of small reads in flight against one
+ * object.  Run it with a small objecter_inflight_ops (e.g. 64, passed in
+ * CEPH_ARGS) so that submitters regularly block on the op throttle,
+ * which is where op_submit used to hold rwlock.
+ */
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "include/rados/librados.hpp"
+#include "common/ceph_time.h"
+#include "common/errno.h"
+
+using namespace std;
+
+void usage(const char *name) {
+  cout << name << " <pool> <threads> <ops> [window]\n"
+       << "\t pool: an existing pool to read from.\n"
+       << "\t threads: the number of submitting threads.\n"
+       << "\t ops: the number of reads per thread.\n"
+       << "\t window: reads each thread keeps in flight (default 16).\n";
+}
+
+int main(int argc, const char **argv)
+{
+  if (argc < 4) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  const string pool = argv[1];
+  const int threads = atoi(argv[2]);
+  const int ops = atoi(argv[3]);
+  const int window = argc > 4 ? atoi(argv[4]) : 16;
+  if (threads <= 0 || ops <= 0 || window <= 0) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  librados::Rados rados;
+  int r = rados.init_with_context(nullptr);
+  if (r == 0)
+    r = rados.conf_read_file(nullptr);
+  if (r == 0)
+    r = rados.conf_parse_env(nullptr);
+  if (r == 0)
+    r = rados.connect();
+  if (r < 0) {
+    cerr << "failed to connect: " << cpp_strerror(r) << std::endl;
+    return EXIT_FAILURE;
+  }
+  librados::IoCtx ioctx;
+  r = rados.ioctx_create(pool.c_str(), ioctx);
+  if (r < 0) {
+    cerr << "failed to open pool " << pool << ": " << cpp_strerror(r)
+	 << std::endl;
+    return EXIT_FAILURE;
+  }
+  const string oid = "bench_objecter_submit";
+  bufferlist bl;
+  bl.append(string(4096, 'x'));
+  r = ioctx.write_full(oid, bl);
+  if (r < 0) {
+    cerr << "failed to write " << oid << ": " << cpp_strerror(r) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << threads << " threads, " << ops << " reads per thread, window "
+       << window << std::endl;
+
+  std::atomic<int> errors = 0;
+  auto start = ceph::mono_clock::now();
+  vector<std::thread> ts;
+  for (int t = 0; t < threads; ++t) {
+    ts.emplace_back([&] {
+      deque<pair<unique_ptr<librados::AioCompletion>,
+		 unique_ptr<bufferlist>>> inflight;
+      auto reap = [&] {
+	auto& [c, out] = inflight.front();
+	c->wait_for_complete();
+	if (c->get_return_value() < 0)
+	  ++errors;
+	inflight.pop_front();
+      };
+      for (int i = 0; i < ops; ++i) {
+	if ((int)inflight.size() >= window)
+	  reap();
+	unique_ptr<librados::AioCompletion> c{
+	  librados::Rados::aio_create_completion()};
+	auto out = make_unique<bufferlist>();
+	ioctx.aio_read(oid, c.get(), out.get(), 512, (i % 8) * 512);
+	inflight.emplace_back(std::move(c), std::move(out));
+      }
+      while (!inflight.empty())
+	reap();
+    });
+  }
+  for (auto& t : ts)
+    t.join();
+  double secs = std::chrono::duration<double>(
+    ceph::mono_clock::now() - start).count();
+
+  ioctx.remove(oid);
+  uint64_t total = uint64_t(threads) * ops;
+  cout << "elapsed " << secs << " s, " << (total / secs) << " ops/s, "
+       << errors << " errors" << std::endl;
+  return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include "include/types.h"
+#include "common/ceph_argparse.h"
+#include "common/ceph_time.h"
+#include "global/global_init.h"
+#include "global/global_context.h"
+#include "osdc/Striper.h"
+
+using namespace std;
+
+struct layout_case {
+  const char *name;
+  uint32_t object_size;
+  uint32_t stripe_unit;
+  uint32_t stripe_count;
+};
+
+static const layout_case layouts[] = {
+  { "rbd-4M",       4 << 20, 4 << 20, 1 },
+  { "object-1M",    1 << 20, 1 << 20, 1 },
+  { "striped-64K-8", 4 << 20, 64 << 10, 8 },
+  { "striped-4K-16", 1 << 20, 4 << 10, 16 },
+};
+
+static const uint64_t io_sizes[] = { 4 << 10, 64 << 10, 1 << 20, 16 << 20 };
+
+static double per_op_ns(ceph::mono_time start, int iters)
+{
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    ceph::mono_clock::now() - start).count();
+  return double(ns) / iters;
+}
+
+void usage(const char *name) {
+  cout << name << " [iterations]\n"
+       << "\t iterations: mappings per layout and I/O size (default 100000).\n";
+}
+
+int main(int argc, const char **argv)
+{
+  int iters = 100000;
+  if (argc > 1) {
+    iters = atoi(argv[1]);
+    if (iters <= 0) {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto args = argv_to_vec(argc, argv);
+  auto cct = global_init(NULL, args, CEPH_ENTITY_TYPE_CLIENT,
+			 CODE_ENVIRONMENT_UTILITY,
+			 CINIT_FLAG_NO_DEFAULT_CONFIG_FILE);
+
+  cout << "layout\tio_size\tlightweight_ns\textents_ns\tassemble_ns"
+       << std::endl;
+  for (auto& lc : layouts) {
+    file_layout_t l;
+    l.object_size = lc.object_size;
+    l.stripe_unit = lc.stripe_unit;
+    l.stripe_count = lc.stripe_count;
+
+    for (auto io_size : io_sizes) {
+      // walk the file so that offsets are not always object aligned
+      uint64_t off_step = io_size + 512;
+      uint64_t span = uint64_t(l.get_period()) * 64;
+
+      auto start = ceph::mono_clock::now();
+      uint64_t off = 0;
+      for (int i = 0; i < iters; ++i) {
+	striper::LightweightObjectExtents extents;
+	Striper::file_to_extents(g_ceph_context, &l, off, io_size, 0, 0,
+				 &extents);
+	off = (off + off_step) % span;
+      }
+      double lightweight = per_op_ns(start, iters);
+
+      start = ceph::mono_clock::now();
+      off = 0;
+      for (int i = 0; i < iters; ++i) {
+	vector<ObjectExtent> extents;
+	Striper::file_to_extents(g_ceph_context, "bench.%016llx", &l, off,
+				 io_size, 0, extents);
+	off = (off + off_step) % span;
+      }
+      double heavyweight = per_op_ns(start, iters);
+
+      // assemble a read result from one zero-filled buffer per object
+      striper::LightweightObjectExtents extents;
+      Striper::file_to_extents(g_ceph_context, &l, 512, io_size, 0, 0,
+			       &extents);
+      int assemble_iters = std::max(iters / 10, 1);
+      start = ceph::mono_clock::now();
+      for (int i = 0; i < assemble_iters; ++i) {
+	Striper::StripedReadResult result;
+	for (auto& ex : extents) {
+	  bufferlist bl;
+	  bl.append_zero(ex.length);
+	  result.add_partial_result(g_ceph_context, std::move(bl),
+				    ex.buffer_extents);
+	}
+	bufferlist out;
+	result.assemble_result(g_ceph_context, out, true);
+	ceph_assert(out.length() == io_size);
+      }
+      double assemble = per_op_ns(start, assemble_iters);
+
+      cout << lc.name << "\t" << io_size << "\t" << lightweight << "\t"
+	   << heavyweight << "\t" << assemble << std::endl;
+    }
+  }
+  return 0;
+}
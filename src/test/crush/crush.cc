@@ -176,6 +176,27 @@ TEST_F(CRUSHTest, indep_out_alt) {
   }
 }
 
+TEST_F(CRUSHTest, do_rule_batch) {
+  std::unique_ptr<CrushWrapper> c(build_indep_map(cct, 3, 3, 3));
+  vector<__u32> weight(c->get_max_devices(), 0x10000);
+  // mark a few osds out so that some inputs need retries
+  weight[1] = 0;
+  weight[5] = 0x8000;
+
+  vector<int> xs;
+  for (int x = 0; x < 1000; ++x) {
+    xs.push_back(x);
+  }
+  vector<vector<int>> batch_out;
+  c->do_rule_batch(0, xs, batch_out, 9, weight, 0);
+  ASSERT_EQ(xs.size(), batch_out.size());
+  for (unsigned i = 0; i < xs.size(); ++i) {
+    vector<int> out;
+    c->do_rule(0, xs[i], out, 9, weight, 0);
+    ASSERT_EQ(out, batch_out[i]) << "x " << xs[i];
+  }
+}
+
 TEST_F(CRUSHTest, indep_out_contig) {
   std::unique_ptr<CrushWrapper> c(build_indep_map(cct, 3, 3, 3));
   vector<__u32> weight(c->get_max_devices(), 0x10000);
@@ -39,6 +39,7 @@ using std::endl;
 using std::cerr;
 using std::cout;
 using std::map;
+using std::pair;
 using std::set;
 using std::string;
 using std::stringstream;
@@ -59,7 +60,8 @@ int ErasureCodeBench::setup(int argc, char** argv) {
     ("plugin,p", po::value<string>()->default_value("jerasure"),
      "erasure code plugin name")
     ("workload,w", po::value<string>()->default_value("encode"),
-     "run either encode or decode")
+     "run either encode, decode or repair (rebuild a single lost chunk "
+     "from what minimum_to_decode asks for, and also report the KB read)")
     ("erasures,e", po::value<int>()->default_value(1),
      "number of erasures when decoding")
     ("erased", po::value<vector<int> >(),
@@ -158,6 +160,8 @@ int ErasureCodeBench::run() {
 
   if (workload == "encode")
     return encode();
+  else if (workload == "repair")
+    return repair();
   else
     return decode();
 }
@@ -325,6 +329,85 @@ int ErasureCodeBench::decode()
   return 0;
 }
 
+int ErasureCodeBench::repair()
+{
+  ErasureCodePluginRegistry &instance = ErasureCodePluginRegistry::instance();
+  ErasureCodeInterfaceRef erasure_code;
+  stringstream messages;
+  int code = instance.factory(plugin,
+			      g_conf().get_val<std::string>("erasure_code_dir"),
+			      profile, &erasure_code, &messages);
+  if (code) {
+    cerr << messages.str() << endl;
+    return code;
+  }
+
+  bufferlist in;
+  in.append(string(in_size, 'X'));
+  in.rebuild_aligned(ErasureCode::SIMD_ALIGN);
+
+  set<int> want_to_encode;
+  for (int i = 0; i < k + m; i++) {
+    want_to_encode.insert(i);
+  }
+
+  map<int,bufferlist> encoded;
+  code = erasure_code->encode(want_to_encode, in, &encoded);
+  if (code)
+    return code;
+
+  int lost = erased.size() > 0 ? erased.front() : rand() % (k + m);
+  if (encoded.count(lost) == 0) {
+    cerr << "chunk " << lost << " does not exist" << endl;
+    return -EINVAL;
+  }
+  set<int> want_to_read = { lost };
+  set<int> available;
+  for (auto &&i : encoded) {
+    if (i.first != lost)
+      available.insert(i.first);
+  }
+
+  // read only the sub-chunks the plugin asks for, like recovery does
+  map<int, vector<pair<int, int>>> minimum;
+  code = erasure_code->minimum_to_decode(want_to_read, available, &minimum);
+  if (code)
+    return code;
+  unsigned chunk_size = encoded[lost].length();
+  unsigned sub_chunk_size = chunk_size / erasure_code->get_sub_chunk_count();
+  map<int,bufferlist> helpers;
+  uint64_t repair_bytes = 0;
+  for (auto &&[chunk, sub_chunks] : minimum) {
+    for (auto &&[index, count] : sub_chunks) {
+      bufferlist tmp;
+      tmp.substr_of(encoded[chunk], index * sub_chunk_size,
+		    count * sub_chunk_size);
+      helpers[chunk].append(tmp);
+    }
+    helpers[chunk].rebuild_aligned(ErasureCode::SIMD_ALIGN);
+    repair_bytes += helpers[chunk].length();
+  }
+  if (verbose)
+    display_chunks(helpers, erasure_code->get_chunk_count());
+
+  utime_t begin_time = ceph_clock_now();
+  for (int i = 0; i < max_iterations; i++) {
+    map<int,bufferlist> decoded;
+    code = erasure_code->decode(want_to_read, helpers, &decoded, chunk_size);
+    if (code)
+      return code;
+    if (i == 0 && !decoded[lost].contents_equal(encoded[lost])) {
+      cerr << "chunk " << lost
+	   << " content and repaired content are different" << endl;
+      return -1;
+    }
+  }
+  utime_t end_time = ceph_clock_now();
+  cout << (end_time - begin_time) << "\t" << (max_iterations * (in_size / 1024))
+       << "\t" << (max_iterations * (repair_bytes / 1024)) << endl;
+  return 0;
+}
+
 int main(int argc, char** argv) {
   ErasureCodeBench ecbench;
   try {
@@ -57,6 +57,7 @@ public:
 		      ErasureCodeInterfaceRef erasure_code);
   int decode();
   int encode();
+  int repair();
 };
 
 #endif
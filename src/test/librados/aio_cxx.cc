@@ -2392,3 +2392,43 @@ TEST(LibRadosAio, MultiReads) {
     ASSERT_EQ(0, memcmp(buf, bl.c_str(), sizeof(buf)));
   }
 }
+
+TEST(LibRadosAio, OperateBatchPP) {
+  AioTestDataPP test_data;
+  ASSERT_EQ("", test_data.init());
+
+  const int num = 8;
+  std::vector<std::string> oids;
+  for (int i = 0; i < num; i++) {
+    oids.push_back("batch" + std::to_string(i));
+    bufferlist bl;
+    bl.append(oids.back());
+    ASSERT_EQ(0, test_data.m_ioctx.write_full(oids.back(), bl));
+  }
+  oids.push_back("batch_missing");
+
+  std::vector<ObjectReadOperation> ops(oids.size());
+  std::vector<ObjectReadOperation*> op_ptrs;
+  for (auto& op : ops) {
+    op.read(0, 0, nullptr, nullptr);
+    op_ptrs.push_back(&op);
+  }
+
+  auto my_completion = std::unique_ptr<AioCompletion>{Rados::aio_create_completion()};
+  std::vector<bufferlist> bls;
+  std::vector<int> rvals;
+  ASSERT_EQ(0, test_data.m_ioctx.aio_operate_batch(oids, my_completion.get(),
+						   op_ptrs, 0, &bls, &rvals));
+  {
+    TestAlarm alarm;
+    ASSERT_EQ(0, my_completion->wait_for_complete());
+  }
+  ASSERT_EQ(-ENOENT, my_completion->get_return_value());
+  ASSERT_EQ(oids.size(), bls.size());
+  ASSERT_EQ(oids.size(), rvals.size());
+  for (int i = 0; i < num; i++) {
+    ASSERT_EQ(0, rvals[i]);
+    ASSERT_EQ(oids[i], bls[i].to_str());
+  }
+  ASSERT_EQ(-ENOENT, rvals[num]);
+}
@@ -9,6 +9,7 @@
 #include "librbd/object_map/DiffRequest.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <boost/scope_exit.hpp>
 
 namespace librbd {
 namespace {
@@ -286,6 +287,74 @@ TEST_F(TestMockObjectMapDiffRequest, EndDelta) {
   ASSERT_EQ(expected_diff_state, m_object_diff_state);
 }
 
+TEST_F(TestMockObjectMapDiffRequest, PackedDelta) {
+  REQUIRE_FEATURE(RBD_FEATURE_FAST_DIFF);
+
+  // enough objects for whole bytes of every state combination plus a tail
+  uint32_t object_count = 67;
+  m_image_ctx->size = object_count * (1 << m_image_ctx->order);
+
+  // per-object logging disables the packed fast path
+  auto& conf = m_image_ctx->cct->_conf;
+  auto debug_rbd = conf.get_val<std::string>("debug_rbd");
+  conf.set_val_or_die("debug_rbd", "0/0");
+  BOOST_SCOPE_EXIT_ALL(&) {
+    conf.set_val_or_die("debug_rbd", debug_rbd);
+  };
+
+  MockTestImageCtx mock_image_ctx(*m_image_ctx);
+  mock_image_ctx.snap_info = {
+    {1U, {"snap1", {cls::rbd::UserSnapshotNamespace{}}, mock_image_ctx.size, {},
+          {}, {}, {}}},
+    {2U, {"snap2", {cls::rbd::UserSnapshotNamespace{}}, mock_image_ctx.size, {},
+          {}, {}, {}}}
+  };
+
+  BitVector<2> object_map_1;
+  BitVector<2> object_map_2;
+  BitVector<2> object_map_head;
+  object_map_1.resize(object_count);
+  object_map_2.resize(object_count);
+  object_map_head.resize(object_count);
+  for (uint32_t i = 0; i < object_count; ++i) {
+    object_map_1[i] = i % 4;
+    object_map_2[i] = (i / 4) % 4;
+    object_map_head[i] = (i / 16) % 4;
+  }
+
+  InSequence seq;
+
+  expect_get_flags(mock_image_ctx, 1U, 0, 0);
+  expect_load_map(mock_image_ctx, 1U, object_map_1, 0);
+  expect_get_flags(mock_image_ctx, 2U, 0, 0);
+  expect_load_map(mock_image_ctx, 2U, object_map_2, 0);
+  expect_get_flags(mock_image_ctx, CEPH_NOSNAP, 0, 0);
+  expect_load_map(mock_image_ctx, CEPH_NOSNAP, object_map_head, 0);
+
+  C_SaferCond ctx;
+  auto req = new MockDiffRequest(&mock_image_ctx, 1, CEPH_NOSNAP,
+                                 &m_object_diff_state, &ctx);
+  req->send();
+  ASSERT_EQ(0, ctx.wait());
+
+  // 0 = HOLE, 1 = DATA, 2 = HOLE_UPDATED, 3 = DATA_UPDATED
+  static const uint8_t expected_states[] = {
+    0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1,
+    0, 2, 2
+  };
+  static_assert(std::size(expected_states) == 67);
+
+  BitVector<2> expected_diff_state;
+  expected_diff_state.resize(object_count);
+  for (uint32_t i = 0; i < object_count; ++i) {
+    expected_diff_state[i] = expected_states[i];
+  }
+  ASSERT_EQ(expected_diff_state, m_object_diff_state);
+}
+
 TEST_F(TestMockObjectMapDiffRequest, StartSnapDNE) {
   REQUIRE_FEATURE(RBD_FEATURE_FAST_DIFF);
 
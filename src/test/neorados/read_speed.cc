@@ -0,0 +1,246 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+/*
+ * Ceph - scalable distributed file system
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License version 2.1, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+
+// Small-read throughput of neorados driven from coroutines, next to the
+// same workload through librados AIO, reported as ops/s and ops per CPU
+// second of this process.
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <fmt/format.h>
+
+#include "include/neorados/RADOS.hpp"
+#include "include/rados/librados.hpp"
+#include "include/scope_guard.h"
+
+#include "common/async/blocked_completion.h"
+#include "common/async/context_pool.h"
+#include "common/ceph_argparse.h"
+#include "common/ceph_time.h"
+#include "common/errno.h"
+
+#include "global/global_init.h"
+
+#include "test/neorados/common_tests.h"
+
+namespace ba = boost::asio;
+namespace bs = boost::system;
+namespace ca = ceph::async;
+namespace R = neorados;
+
+struct config {
+  int objects = 128;
+  int concurrency = 32;
+  int seconds = 10;
+  std::uint64_t block_size = 4096;
+};
+
+static double cpu_seconds()
+{
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+    ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+static std::string oid(int n)
+{
+  return fmt::format("read_speed.{}", n);
+}
+
+static void report(std::string_view name, std::uint64_t ops, double wall,
+		   double cpu)
+{
+  std::cout << name << ": " << ops << " ops in " << wall << " s, "
+	    << ops / wall << " ops/s, " << ops / cpu << " ops/cpu-s"
+	    << std::endl;
+}
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+static ba::awaitable<void> reader(R::RADOS& r, const R::IOContext& ioc,
+				  const config& c, int id,
+				  ceph::mono_time end, std::uint64_t& ops)
+{
+  for (int n = id; ceph::mono_clock::now() < end; n += c.concurrency) {
+    R::ReadOp op;
+    ceph::bufferlist bl;
+    op.read(0, c.block_size, &bl);
+    co_await r.execute(oid(n % c.objects), ioc, std::move(op), nullptr,
+		       ba::use_awaitable);
+    ++ops;
+  }
+}
+
+static void bench_neorados(R::RADOS& r, const R::IOContext& ioc,
+			   const config& c)
+{
+  std::mutex lock;
+  std::condition_variable cond;
+  int running = c.concurrency;
+  std::vector<std::uint64_t> ops(c.concurrency, 0);
+
+  auto start = ceph::mono_clock::now();
+  auto end = start + std::chrono::seconds(c.seconds);
+  double cpu_start = cpu_seconds();
+  for (int i = 0; i < c.concurrency; ++i) {
+    ba::co_spawn(r.get_executor(), reader(r, ioc, c, i, end, ops[i]),
+		 [&](std::exception_ptr e) {
+		   if (e) try {
+		     std::rethrow_exception(e);
+		   } catch (const std::exception& ex) {
+		     std::cerr << "reader failed: " << ex.what() << std::endl;
+		   }
+		   std::lock_guard l(lock);
+		   if (--running == 0)
+		     cond.notify_all();
+		 });
+  }
+  {
+    std::unique_lock l(lock);
+    cond.wait(l, [&] { return running == 0; });
+  }
+  double wall = std::chrono::duration<double>(
+    ceph::mono_clock::now() - start).count();
+  std::uint64_t total = 0;
+  for (auto n : ops)
+    total += n;
+  report("neorados co_await", total, wall, cpu_seconds() - cpu_start);
+}
+#endif
+
+static int bench_librados(CephContext* cct, const std::string& pool_name,
+			  const config& c)
+{
+  librados::Rados rados;
+  int r = rados.init_with_context(cct);
+  if (r < 0)
+    return r;
+  r = rados.connect();
+  if (r < 0)
+    return r;
+  librados::IoCtx ioctx;
+  r = rados.ioctx_create(pool_name.c_str(), ioctx);
+  if (r < 0)
+    return r;
+
+  std::vector<librados::AioCompletion*> slots(c.concurrency, nullptr);
+  std::vector<ceph::bufferlist> bufs(c.concurrency);
+  std::uint64_t ops = 0;
+  int n = 0;
+
+  auto start = ceph::mono_clock::now();
+  auto end = start + std::chrono::seconds(c.seconds);
+  double cpu_start = cpu_seconds();
+  for (int i = 0; ; i = (i + 1) % c.concurrency) {
+    if (slots[i]) {
+      slots[i]->wait_for_complete();
+      slots[i]->release();
+      slots[i] = nullptr;
+      ++ops;
+    }
+    if (ceph::mono_clock::now() >= end) {
+      bool idle = true;
+      for (auto s : slots)
+	idle = idle && !s;
+      if (idle)
+	break;
+      continue;
+    }
+    bufs[i].clear();
+    slots[i] = librados::Rados::aio_create_completion();
+    ioctx.aio_read(oid(n++ % c.objects), slots[i], &bufs[i], c.block_size, 0);
+  }
+  double wall = std::chrono::duration<double>(
+    ceph::mono_clock::now() - start).count();
+  report("librados aio", ops, wall, cpu_seconds() - cpu_start);
+  rados.shutdown();
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  using namespace std::literals;
+
+  auto args = argv_to_vec(argc, argv);
+  env_to_vec(args);
+
+  auto cct = global_init(NULL, args, CEPH_ENTITY_TYPE_CLIENT,
+			 CODE_ENVIRONMENT_UTILITY, 0);
+  common_init_finish(cct.get());
+
+  config c;
+  std::string val;
+  for (auto i = args.begin(); i != args.end(); ) {
+    if (ceph_argparse_witharg(args, i, &val, "--objects", (char*)NULL)) {
+      c.objects = std::stoi(val);
+    } else if (ceph_argparse_witharg(args, i, &val, "--concurrency",
+				     (char*)NULL)) {
+      c.concurrency = std::stoi(val);
+    } else if (ceph_argparse_witharg(args, i, &val, "--seconds",
+				     (char*)NULL)) {
+      c.seconds = std::stoi(val);
+    } else if (ceph_argparse_witharg(args, i, &val, "--block-size",
+				     (char*)NULL)) {
+      c.block_size = std::stoull(val);
+    } else {
+      std::cerr << "unknown option " << *i << std::endl;
+      return 1;
+    }
+  }
+
+  try {
+    ca::io_context_pool p(1);
+    auto r = R::RADOS::make_with_cct(cct.get(), p, ca::use_blocked);
+
+    auto pool_name = get_temp_pool_name("ceph_test_neorados_read_speed"sv);
+    r.create_pool(pool_name, std::nullopt, ca::use_blocked);
+    auto pd = make_scope_guard(
+      [&pool_name, &r]() {
+	r.delete_pool(pool_name, ca::use_blocked);
+      });
+    R::IOContext ioc(r.lookup_pool(pool_name, ca::use_blocked));
+
+    ceph::bufferlist data;
+    data.append_zero(c.block_size);
+    for (int n = 0; n < c.objects; ++n) {
+      R::WriteOp op;
+      op.write_full(ceph::bufferlist{data});
+      r.execute(oid(n), ioc, std::move(op), ca::use_blocked);
+    }
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    bench_neorados(r, ioc, c);
+#else
+    std::cerr << "coroutines unavailable, skipping neorados" << std::endl;
+#endif
+    int ret = bench_librados(cct.get(), pool_name, c);
+    if (ret < 0) {
+      std::cerr << "librados: " << cpp_strerror(ret) << std::endl;
+      return 1;
+    }
+  } catch (const bs::system_error& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
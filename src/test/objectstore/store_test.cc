@@ -672,6 +672,80 @@ TEST_P(StoreTest, FiemapHoles) {
   }
 }
 
+TEST_P(StoreTest, VerifyDigest) {
+  coll_t cid;
+  int r = 0;
+  ghobject_t oid(hobject_t(sobject_t("verify_object", CEPH_NOSNAP)));
+  auto ch = store->create_new_collection(cid);
+  {
+    ObjectStore::Transaction t;
+    t.create_collection(cid, 0);
+    r = queue_transaction(store, ch, std::move(t));
+    ASSERT_EQ(r, 0);
+  }
+  {
+    // aligned and unaligned extents with holes in between
+    ObjectStore::Transaction t;
+    bufferlist a, b, c;
+    a.append(buffer::create(65536));
+    memset(a.c_str(), 'a', a.length());
+    b.append(buffer::create(5000));
+    memset(b.c_str(), 'b', b.length());
+    c.append(buffer::create(300000));
+    for (unsigned i = 0; i < c.length(); ++i) {
+      c.c_str()[i] = static_cast<char>(rand());
+    }
+    t.write(cid, oid, 0, a.length(), a);
+    t.write(cid, oid, 100000, b.length(), b);
+    t.write(cid, oid, 131072 + 1234, c.length(), c);
+    r = queue_transaction(store, ch, std::move(t));
+    ASSERT_EQ(r, 0);
+  }
+  auto check = [&](uint64_t off, uint64_t len) {
+    bufferlist bl;
+    int rr = store->read(ch, oid, off, len, bl);
+    ASSERT_GE(rr, 0);
+    uint32_t digest = -1;
+    int rv = store->verify(ch, oid, off, len, &digest,
+			   CEPH_OSD_OP_FLAG_BYPASS_CLEAN_CACHE);
+    ASSERT_EQ(rr, rv);
+    ASSERT_EQ(bl.crc32c(-1), digest);
+  };
+  check(0, 0);
+  check(0, 1 << 20);
+  check(4096, 65536);
+  check(1, 200000);
+  check(99999, 5002);
+  check(131072, 65536);
+  check(431072, 65536);
+  check(1 << 20, 4096);
+  {
+    // chained, like deep scrub does
+    bufferlist bl;
+    r = store->read(ch, oid, 0, 1 << 20, bl);
+    ASSERT_GT(r, 0);
+    uint32_t digest = -1;
+    uint64_t pos = 0;
+    while (true) {
+      int rv = store->verify(ch, oid, pos, 65536, &digest);
+      ASSERT_GE(rv, 0);
+      pos += rv;
+      if (rv < 65536) {
+	break;
+      }
+    }
+    ASSERT_EQ(bl.length(), pos);
+    ASSERT_EQ(bl.crc32c(-1), digest);
+  }
+  {
+    ObjectStore::Transaction t;
+    t.remove(cid, oid);
+    t.remove_collection(cid);
+    r = queue_transaction(store, ch, std::move(t));
+    ASSERT_EQ(r, 0);
+  }
+}
+
 TEST_P(StoreTest, SimpleMetaColTest) {
   coll_t cid;
   int r = 0;
@@ -7,6 +7,7 @@
 #include "global/global_context.h"
 #include "global/global_init.h"
 #include "common/common_init.h"
+#include "common/ceph_json.h"
 
 #include "osd/scheduler/mClockScheduler.h"
 #include "osd/scheduler/OpSchedulerItem.h"
@@ -47,8 +48,9 @@ public:
   struct MockDmclockItem : public PGOpQueueable {
     op_scheduler_class scheduler_class;
 
-    MockDmclockItem(op_scheduler_class _scheduler_class) :
-      PGOpQueueable(spg_t()),
+    MockDmclockItem(op_scheduler_class _scheduler_class,
+		    spg_t pgid = spg_t()) :
+      PGOpQueueable(pgid),
       scheduler_class(_scheduler_class) {}
 
     MockDmclockItem()
@@ -169,3 +171,161 @@ TEST_F(mClockSchedulerTest, TestMultiClientOrderedEnqueueDequeue) {
   }
   ASSERT_TRUE(q.empty());
 }
+
+TEST_F(mClockSchedulerTest, TestPoolQoS) {
+  OSDMap osdmap;
+  uuid_d fsid;
+  osdmap.build_simple(g_ceph_context, 0, fsid, 1);
+
+  OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+  inc.fsid = osdmap.get_fsid();
+  inc.new_pool_max = osdmap.get_pool_max();
+  pg_pool_t empty;
+  int64_t pool_id = ++inc.new_pool_max;
+  pg_pool_t *p = inc.get_new_pool(pool_id, &empty);
+  p->size = 1;
+  p->set_pg_num(8);
+  p->set_pgp_num(8);
+  p->type = pg_pool_t::TYPE_REPLICATED;
+  p->crush_rule = 0;
+  p->opts.set(pool_opts_t::MCLOCK_CLIENT_WGT, static_cast<int64_t>(5));
+  p->opts.set(pool_opts_t::MCLOCK_CLIENT_LIM, static_cast<int64_t>(100));
+  inc.new_pool_names[pool_id] = "qos";
+  osdmap.apply_incremental(inc);
+
+  q.update_pool_qos(osdmap);
+
+  spg_t qos_pgid(pg_t(0, pool_id));
+  auto default_info = q.get_client_info(
+    create_item(100, client1, op_scheduler_class::client));
+  auto pool_info = q.get_client_info(
+    create_item(100, client1, op_scheduler_class::client, qos_pgid));
+  ASSERT_NE(default_info, pool_info);
+  ASSERT_EQ(5.0, pool_info->weight);
+  ASSERT_EQ(100.0, pool_info->limit);
+  // unset values are inherited from the default client info
+  ASSERT_EQ(default_info->reservation, pool_info->reservation);
+
+  // background items are not affected by pool QoS
+  auto recovery_info = q.get_client_info(
+    create_item(100, client1, op_scheduler_class::background_recovery,
+		qos_pgid));
+  ASSERT_NE(pool_info, recovery_info);
+
+  for (unsigned i = 100; i < 105; ++i) {
+    q.enqueue(create_item(i, client1, op_scheduler_class::client, qos_pgid));
+    q.enqueue(create_item(i, client2, op_scheduler_class::client));
+  }
+
+  // clearing the pool options falls back to the defaults
+  OSDMap::Incremental unset_inc(osdmap.get_epoch() + 1);
+  unset_inc.fsid = osdmap.get_fsid();
+  p = unset_inc.get_new_pool(pool_id, osdmap.get_pg_pool(pool_id));
+  p->opts.unset(pool_opts_t::MCLOCK_CLIENT_WGT);
+  p->opts.unset(pool_opts_t::MCLOCK_CLIENT_LIM);
+  osdmap.apply_incremental(unset_inc);
+
+  q.update_pool_qos(osdmap);
+
+  ASSERT_EQ(default_info, q.get_client_info(
+    create_item(100, client1, op_scheduler_class::client, qos_pgid)));
+
+  for (unsigned i = 0; i < 10; ++i) {
+    ASSERT_FALSE(q.empty());
+    q.dequeue();
+  }
+  ASSERT_TRUE(q.empty());
+}
+
+TEST_F(mClockSchedulerTest, TestPoolQoSToggleOrder) {
+  OSDMap osdmap;
+  uuid_d fsid;
+  osdmap.build_simple(g_ceph_context, 0, fsid, 1);
+
+  OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+  inc.fsid = osdmap.get_fsid();
+  inc.new_pool_max = osdmap.get_pool_max();
+  pg_pool_t empty;
+  int64_t pool_id = ++inc.new_pool_max;
+  pg_pool_t *p = inc.get_new_pool(pool_id, &empty);
+  p->size = 1;
+  p->set_pg_num(8);
+  p->set_pgp_num(8);
+  p->type = pg_pool_t::TYPE_REPLICATED;
+  p->crush_rule = 0;
+  inc.new_pool_names[pool_id] = "qos";
+  osdmap.apply_incremental(inc);
+  q.update_pool_qos(osdmap);
+
+  auto set_wgt = [&](int64_t wgt) {
+    OSDMap::Incremental wgt_inc(osdmap.get_epoch() + 1);
+    wgt_inc.fsid = osdmap.get_fsid();
+    auto np = wgt_inc.get_new_pool(pool_id, osdmap.get_pg_pool(pool_id));
+    if (wgt) {
+      np->opts.set(pool_opts_t::MCLOCK_CLIENT_WGT, wgt);
+    } else {
+      np->opts.unset(pool_opts_t::MCLOCK_CLIENT_WGT);
+    }
+    osdmap.apply_incremental(wgt_inc);
+    q.update_pool_qos(osdmap);
+  };
+
+  // ops queued before the pool gains and loses its profile must still
+  // be dequeued ahead of the ones queued after
+  spg_t pgid(pg_t(0, pool_id));
+  auto default_info = q.get_client_info(
+    create_item(100, client1, op_scheduler_class::client));
+  for (unsigned i = 100; i < 105; ++i) {
+    q.enqueue(create_item(i, client1, op_scheduler_class::client, pgid));
+  }
+  set_wgt(5);
+  ASSERT_NE(default_info, q.get_client_info(
+    create_item(100, client1, op_scheduler_class::client, pgid)));
+  for (unsigned i = 105; i < 110; ++i) {
+    q.enqueue(create_item(i, client1, op_scheduler_class::client, pgid));
+  }
+  set_wgt(0);
+  ASSERT_EQ(default_info, q.get_client_info(
+    create_item(100, client1, op_scheduler_class::client, pgid)));
+  for (unsigned i = 110; i < 115; ++i) {
+    q.enqueue(create_item(i, client1, op_scheduler_class::client, pgid));
+  }
+
+  for (unsigned i = 100; i < 115; ++i) {
+    ASSERT_FALSE(q.empty());
+    auto r = get_item(q.dequeue());
+    ASSERT_EQ(i, r.get_map_epoch());
+  }
+  ASSERT_TRUE(q.empty());
+}
+
+TEST_F(mClockSchedulerTest, TestPoolWithoutQoS) {
+  // without pool QoS settings a client's ops in different pools share a
+  // single dmclock client, as before per-pool QoS existed
+  spg_t pgid_a(pg_t(0, 1));
+  spg_t pgid_b(pg_t(0, 2));
+  for (unsigned i = 100; i < 105; ++i) {
+    q.enqueue(create_item(i, client1, op_scheduler_class::client, pgid_a));
+    q.enqueue(create_item(i, client1, op_scheduler_class::client, pgid_b));
+  }
+
+  JSONFormatter f;
+  f.open_object_section("scheduler");
+  q.dump(f);
+  f.close_section();
+  std::stringstream ss;
+  f.flush(ss);
+  JSONParser parser;
+  ASSERT_TRUE(parser.parse(ss.str().c_str(), ss.str().size()));
+  auto clients = parser.find_obj("mClockClients");
+  ASSERT_NE(nullptr, clients);
+  auto count = clients->find_obj("client_count");
+  ASSERT_NE(nullptr, count);
+  ASSERT_EQ("1", count->get_data());
+
+  for (unsigned i = 0; i < 10; ++i) {
+    ASSERT_FALSE(q.empty());
+    q.dequeue();
+  }
+  ASSERT_TRUE(q.empty());
+}
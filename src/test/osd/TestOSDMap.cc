@@ -163,6 +163,50 @@ public:
     }
     return ruleno;
   }
+  void update_mapping() {
+    mapping.update(osdmap);
+  }
+  void start_update_and_wait() {
+    ThreadPool tp(g_ceph_context, "OSDMapTest::mapping_tp", "mapping_tp", 2);
+    tp.start();
+    ParallelPGMapper mapper(g_ceph_context, &tp);
+    auto job = mapping.start_update(osdmap, mapper, 16);
+    job->wait();
+    tp.stop();
+  }
+  size_t num_pending_changes() const {
+    return mapping.pending_changes.size();
+  }
+  void check_mapping() {
+    for (auto& [pool, pi] : osdmap.get_pools()) {
+      for (unsigned ps = 0; ps < pi.get_pg_num(); ++ps) {
+	pg_t pgid(ps, pool);
+	vector<int> up, acting, up2, acting2;
+	int up_primary, acting_primary, up_primary2, acting_primary2;
+	osdmap.pg_to_up_acting_osds(pgid, &up, &up_primary,
+				    &acting, &acting_primary);
+	mapping.get(pgid, &up2, &up_primary2, &acting2, &acting_primary2);
+	ASSERT_EQ(up, up2);
+	ASSERT_EQ(up_primary, up_primary2);
+	ASSERT_EQ(acting, acting2);
+	ASSERT_EQ(acting_primary, acting_primary2);
+      }
+    }
+  }
+  // reverse the acting set of pgid with a pg_temp
+  void apply_pg_temp(pg_t pgid, bool note) {
+    vector<int> up, acting;
+    int up_primary, acting_primary;
+    osdmap.pg_to_up_acting_osds(pgid, &up, &up_primary,
+				&acting, &acting_primary);
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    inc.new_pg_temp[pgid] = mempool::osdmap::vector<int>(
+      acting.rbegin(), acting.rend());
+    osdmap.apply_incremental(inc);
+    if (note) {
+      mapping.note_incremental(osdmap, inc);
+    }
+  }
   void test_mappings(int pool,
 		     int num,
 		     vector<int> *any,
@@ -348,6 +392,199 @@ TEST_F(OSDMapTest, PGTempRespected) {
   EXPECT_EQ(new_acting_osds, acting_osds);
 }
 
+TEST_F(OSDMapTest, PGsChangedBy) {
+  set_up_map();
+  update_mapping();
+
+  auto remap_and_check = [this](const OSDMap::Incremental& inc) {
+    set<int64_t> pools;
+    set<pg_t> pgs;
+    ASSERT_TRUE(osdmap.get_pgs_changed_by(inc, &pools, &pgs));
+    for (auto pool : pools) {
+      for (unsigned ps = 0; ps < osdmap.get_pg_pool(pool)->get_pg_num(); ++ps) {
+	mapping.update(osdmap, pg_t(ps, pool));
+      }
+    }
+    for (auto pgid : pgs) {
+      mapping.update(osdmap, pgid);
+    }
+    // the partial remap must match a full one
+    check_mapping();
+  };
+
+  pg_t pgid = osdmap.raw_pg_to_pg(pg_t(0, my_rep_pool));
+  {
+    // a pg_temp only touches its own pg
+    vector<int> up, acting;
+    int up_primary, acting_primary;
+    osdmap.pg_to_up_acting_osds(pgid, &up, &up_primary,
+				&acting, &acting_primary);
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    inc.new_pg_temp[pgid] = mempool::osdmap::vector<int>(
+      acting.rbegin(), acting.rend());
+    osdmap.apply_incremental(inc);
+    set<int64_t> pools;
+    set<pg_t> pgs;
+    ASSERT_TRUE(osdmap.get_pgs_changed_by(inc, &pools, &pgs));
+    EXPECT_TRUE(pools.empty());
+    EXPECT_EQ(set<pg_t>{pgid}, pgs);
+    remap_and_check(inc);
+  }
+  {
+    // marking an osd down touches every pool whose rule can reach it,
+    // and every explicitly remapped pg
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    inc.new_state[0] = CEPH_OSD_UP;
+    osdmap.apply_incremental(inc);
+    ASSERT_TRUE(osdmap.is_down(0));
+    set<int64_t> pools;
+    set<pg_t> pgs;
+    ASSERT_TRUE(osdmap.get_pgs_changed_by(inc, &pools, &pgs));
+    EXPECT_EQ((set<int64_t>{my_ec_pool, my_rep_pool}), pools);
+    EXPECT_EQ(1u, pgs.count(pgid));
+    remap_and_check(inc);
+  }
+  {
+    // a legacy new_state of 0 also marks an osd down
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    inc.new_state[2] = 0;
+    osdmap.apply_incremental(inc);
+    ASSERT_TRUE(osdmap.is_down(2));
+    set<int64_t> pools;
+    set<pg_t> pgs;
+    ASSERT_TRUE(osdmap.get_pgs_changed_by(inc, &pools, &pgs));
+    EXPECT_EQ((set<int64_t>{my_ec_pool, my_rep_pool}), pools);
+    remap_and_check(inc);
+  }
+  {
+    // a full-flag change does not move anything
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    inc.new_state[1] = CEPH_OSD_FULL;
+    osdmap.apply_incremental(inc);
+    set<int64_t> pools;
+    set<pg_t> pgs;
+    ASSERT_TRUE(osdmap.get_pgs_changed_by(inc, &pools, &pgs));
+    EXPECT_TRUE(pools.empty());
+    EXPECT_TRUE(pgs.empty());
+  }
+  {
+    // a new crush map can move anything
+    CrushWrapper newcrush;
+    get_crush(osdmap, newcrush);
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    newcrush.encode(inc.crush, CEPH_FEATURES_SUPPORTED_DEFAULT);
+    osdmap.apply_incremental(inc);
+    set<int64_t> pools;
+    set<pg_t> pgs;
+    EXPECT_FALSE(osdmap.get_pgs_changed_by(inc, &pools, &pgs));
+  }
+}
+
+TEST_F(OSDMapTest, MappingStartUpdate) {
+  set_up_map();
+  start_update_and_wait();
+  ASSERT_EQ(osdmap.get_epoch(), mapping.get_epoch());
+  check_mapping();
+
+  // noted incrementals are remapped incrementally
+  apply_pg_temp(osdmap.raw_pg_to_pg(pg_t(0, my_rep_pool)), true);
+  apply_pg_temp(osdmap.raw_pg_to_pg(pg_t(1, my_ec_pool)), true);
+  EXPECT_EQ(2u, num_pending_changes());
+  start_update_and_wait();
+  ASSERT_EQ(osdmap.get_epoch(), mapping.get_epoch());
+  check_mapping();
+
+  // an epoch that was never noted forces a full remap; a partial one
+  // would miss this pg_temp
+  apply_pg_temp(osdmap.raw_pg_to_pg(pg_t(2, my_rep_pool)), false);
+  apply_pg_temp(osdmap.raw_pg_to_pg(pg_t(3, my_rep_pool)), true);
+  start_update_and_wait();
+  ASSERT_EQ(osdmap.get_epoch(), mapping.get_epoch());
+  check_mapping();
+  EXPECT_EQ(0u, num_pending_changes());
+}
+
+TEST_F(OSDMapTest, MappingTooManyPendingChanges) {
+  set_up_map();
+  start_update_and_wait();
+
+  // once the records overflow the older ones are dropped, so the
+  // pg_temp from the first epoch is only picked up by a full remap
+  apply_pg_temp(osdmap.raw_pg_to_pg(pg_t(0, my_rep_pool)), true);
+  pg_t pgid = osdmap.raw_pg_to_pg(pg_t(1, my_rep_pool));
+  for (unsigned i = 0; i < 120; ++i) {
+    apply_pg_temp(pgid, true);
+  }
+  EXPECT_LT(num_pending_changes(), 121u);
+  start_update_and_wait();
+  ASSERT_EQ(osdmap.get_epoch(), mapping.get_epoch());
+  check_mapping();
+}
+
+TEST_F(OSDMapTest, MappingNothingChanged) {
+  set_up_map();
+  start_update_and_wait();
+
+  // nothing to remap: the job completes without queuing any work
+  OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+  inc.new_state[1] = CEPH_OSD_FULL;
+  osdmap.apply_incremental(inc);
+  mapping.note_incremental(osdmap, inc);
+
+  ThreadPool tp(g_ceph_context, "OSDMapTest::mapping_tp", "mapping_tp", 1);
+  ParallelPGMapper mapper(g_ceph_context, &tp);
+  // the pool is never started, so queued work would never finish
+  auto job = mapping.start_update(osdmap, mapper, 16);
+  ASSERT_TRUE(job->is_done());
+  EXPECT_EQ(osdmap.get_epoch(), mapping.get_epoch());
+  check_mapping();
+}
+
+TEST_F(OSDMapTest, Dedup) {
+  set_up_map();
+  {
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    inc.new_require_osd_release = ceph_release();
+    inc.new_primary_affinity[0] = 0x8000;
+    osdmap.apply_incremental(inc);
+  }
+
+  // decode independent copies, as the osd does for every epoch
+  auto decode_copy = [this](OSDMap *m) {
+    bufferlist bl;
+    osdmap.encode(bl, CEPH_FEATURES_SUPPORTED_DEFAULT | CEPH_FEATURE_RESERVED);
+    m->decode(bl);
+  };
+  OSDMap oldmap;
+  decode_copy(&oldmap);
+  {
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    inc.new_weight[1] = CEPH_OSD_OUT;
+    osdmap.apply_incremental(inc);
+  }
+  OSDMap newmap;
+  decode_copy(&newmap);
+  ASSERT_NE(oldmap.crush, newmap.crush);
+  OSDMap::dedup(&oldmap, &newmap);
+  EXPECT_EQ(oldmap.crush, newmap.crush);
+  EXPECT_EQ(0x8000u, newmap.get_primary_affinity(0));
+
+  // a crush change bumps crush_version, but an identical crush map is
+  // still shared
+  {
+    CrushWrapper newcrush;
+    get_crush(osdmap, newcrush);
+    OSDMap::Incremental inc(osdmap.get_epoch() + 1);
+    newcrush.encode(inc.crush, CEPH_FEATURES_SUPPORTED_DEFAULT);
+    osdmap.apply_incremental(inc);
+  }
+  OSDMap crushmap;
+  decode_copy(&crushmap);
+  ASSERT_NE(oldmap.get_crush_version(), crushmap.get_crush_version());
+  OSDMap::dedup(&oldmap, &crushmap);
+  EXPECT_EQ(oldmap.crush, crushmap.crush);
+}
+
 TEST_F(OSDMapTest, PrimaryTempRespected) {
   set_up_map();
 
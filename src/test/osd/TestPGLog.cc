@@ -2912,6 +2912,31 @@ TEST_F(PGLogTrimTest, TestGetRequest) {
   EXPECT_FALSE(result);
 }
 
+TEST_F(PGLogTrimTest, TestIndexMempool) {
+  SetUp(20);
+  PGLog::IndexedLog log;
+  log.head = mk_evt(20, 0);
+  log.skip_can_rollback_to_to_head();
+  log.head = mk_evt(9, 0);
+
+  entity_name_t client = entity_name_t::CLIENT(777);
+  for (unsigned i = 1; i <= 32; ++i) {
+    log.add(mk_ple_mod(mk_obj(i), mk_evt(10, 100 + i), mk_evt(8, 70),
+		       osd_reqid_t(client, 8, i)));
+  }
+
+  // the object and caller_ops indexes are charged to the osd_pglog mempool
+  size_t unindexed_bytes = mempool::osd_pglog::allocated_bytes();
+  log.index();
+  EXPECT_EQ(32u, log.objects.size());
+  EXPECT_EQ(32u, log.caller_ops.size());
+  size_t indexed_bytes = mempool::osd_pglog::allocated_bytes();
+  EXPECT_GT(indexed_bytes, unindexed_bytes);
+
+  log.unindex();
+  EXPECT_LT(mempool::osd_pglog::allocated_bytes(), indexed_bytes);
+}
+
 TEST_F(PGLogTest, _merge_object_divergent_entries) {
   {
     // Test for issue 20843
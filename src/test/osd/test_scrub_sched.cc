@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <map>
 
+#include <boost/scope_exit.hpp>
+
 #include "common/async/context_pool.h"
 #include "common/ceph_argparse.h"
 #include "global/global_context.h"
@@ -63,6 +65,11 @@ class ScrubSchedTestWrapper : public ScrubQueue {
     return ScrubQueue::collect_ripe_jobs(to_scrub, time_now());
   }
 
+  bool scrub_client_io_permit() const
+  {
+    return ScrubQueue::scrub_client_io_permit();
+  }
+
   /**
    * unit-test support for faking the current time. When
    * not activated specifically - the default is to use ceph_clock_now()
@@ -400,3 +407,55 @@ TEST_F(TestScrubSched, ready_list)
   EXPECT_EQ(4, ripe_jobs.size());
   debug_print_jobs("ready_list", ripe_jobs);
 }
+
+/// high client op latency should only permit deadlined scrubs
+TEST_F(TestScrubSched, client_latency)
+{
+  auto& conf = g_ceph_context->_conf;
+  std::map<std::string, std::string> saved_conf;
+  for (const char* key : {"osd_scrub_client_latency_threshold",
+			  "osd_scrub_sleep",
+			  "osd_scrub_extended_sleep"}) {
+    ASSERT_EQ(0, conf.get_val(key, &saved_conf[key]));
+  }
+  BOOST_SCOPE_EXIT_ALL(&) {
+    for (const auto& [key, val] : saved_conf) {
+      conf.set_val_or_die(key, val);
+    }
+  };
+
+  conf.set_val_or_die("osd_scrub_client_latency_threshold", "10");
+  conf.set_val_or_die("osd_scrub_sleep", "0");
+  conf.set_val_or_die("osd_scrub_extended_sleep", "0.5");
+
+  // no client ops at all
+  m_sched->update_client_io_stats(0, 0);
+  EXPECT_TRUE(m_sched->scrub_client_io_permit());
+
+  // 100 ops at 20ms each
+  m_sched->update_client_io_stats(100 * 20'000'000ull, 100);
+  EXPECT_FALSE(m_sched->scrub_client_io_permit());
+  // non-deadlined scrubs are paced with the extended sleep
+  EXPECT_EQ(0.5, m_sched->scrub_sleep_time(false));
+  EXPECT_EQ(0.0, m_sched->scrub_sleep_time(true));
+  EXPECT_GT(m_sched->scrub_sleep_time(false), m_sched->scrub_sleep_time(true));
+
+  // 1000 more ops at 1ms each
+  m_sched->update_client_io_stats(100 * 20'000'000ull + 1000 * 1'000'000ull,
+				  1100);
+  EXPECT_TRUE(m_sched->scrub_client_io_permit());
+
+  // an idle interval does not block scrubs
+  m_sched->update_client_io_stats(100 * 20'000'000ull + 1000 * 1'000'000ull,
+				  1100);
+  EXPECT_TRUE(m_sched->scrub_client_io_permit());
+
+  // disabled
+  m_sched->update_client_io_stats(100 * 20'000'000ull + 1100 * 1'000'000ull +
+				    100 * 50'000'000ull,
+				  1300);
+  EXPECT_FALSE(m_sched->scrub_client_io_permit());
+  conf.set_val_or_die("osd_scrub_client_latency_threshold", "0");
+  EXPECT_TRUE(m_sched->scrub_client_io_permit());
+  EXPECT_EQ(0.0, m_sched->scrub_sleep_time(false));
+}
@@ -23,6 +23,7 @@
 #include "MemWriteback.h"
 
 #include <atomic>
+#include <thread>
 
 using namespace std;
 
@@ -175,6 +176,122 @@ int stress_test(uint64_t num_ops, uint64_t num_objs,
   return EXIT_SUCCESS;
 }
 
+// Many threads, each driving its own ObjectSet (file) through one shared
+// cache, to measure how much throughput the cache lock leaves on the table.
+int throughput_test(uint64_t num_threads, uint64_t num_files,
+		    uint64_t ops_per_thread, uint64_t max_obj_size,
+		    uint64_t delay_ns, uint64_t max_op_len, float percent_reads)
+{
+  ceph::mutex lock = ceph::make_mutex("object_cacher_stress::object_cacher");
+  FakeWriteback writeback(g_ceph_context, &lock, delay_ns);
+
+  ObjectCacher obc(g_ceph_context, "test", writeback, lock, NULL, NULL,
+		   g_conf()->client_oc_size,
+		   g_conf()->client_oc_max_objects,
+		   g_conf()->client_oc_max_dirty,
+		   g_conf()->client_oc_target_dirty,
+		   g_conf()->client_oc_max_dirty_age,
+		   true);
+  obc.start();
+
+  std::cout << "Test configuration:\n\n"
+	    << setw(10) << "threads: " << num_threads << "\n"
+	    << setw(10) << "files: " << num_files << "\n"
+	    << setw(10) << "ops/thread: " << ops_per_thread << "\n"
+	    << setw(10) << "obj size: " << max_obj_size << "\n"
+	    << setw(10) << "delay: " << delay_ns << "\n"
+	    << setw(10) << "max op len: " << max_op_len << "\n"
+	    << setw(10) << "percent reads: " << percent_reads << "\n\n";
+
+  std::vector<std::unique_ptr<ObjectCacher::ObjectSet>> sets;
+  for (uint64_t f = 0; f < num_files; ++f) {
+    sets.emplace_back(new ObjectCacher::ObjectSet(NULL, 0, f));
+  }
+
+  std::atomic<uint64_t> bytes_read = { 0 };
+  std::atomic<uint64_t> bytes_written = { 0 };
+  std::atomic<uint64_t> journal_tid = { 0 };
+  ceph::bufferlist bl;
+  bl.append_zero(max_op_len);
+
+  auto worker = [&](uint64_t t) {
+    unsigned seed = t + 1;
+    SnapContext snapc;
+    for (uint64_t i = 0; i < ops_per_thread; ++i) {
+      uint64_t f = rand_r(&seed) % num_files;
+      uint64_t offset = rand_r(&seed) % max_obj_size;
+      uint64_t max_len = std::min(max_obj_size - offset, max_op_len);
+      uint64_t length = rand_r(&seed) % (std::max<uint64_t>(max_len - 1, 1)) + 1;
+      std::string oid = "file" + stringify(f) + ".obj";
+      bool is_read = rand_r(&seed) < percent_reads * float(RAND_MAX);
+      op_data op(oid, offset, length, is_read);
+      if (is_read) {
+	ObjectCacher::OSDRead *rd = obc.prepare_read(CEPH_NOSNAP, &op.result, 0);
+	rd->extents.push_back(op.extent);
+	C_SaferCond cond;
+	lock.lock();
+	int r = obc.readx(rd, sets[f].get(), &cond);
+	lock.unlock();
+	ceph_assert(r >= 0);
+	if (r == 0)
+	  r = cond.wait();
+	bytes_read += r;
+      } else {
+	ceph::bufferlist wbl;
+	wbl.substr_of(bl, 0, length);
+	ObjectCacher::OSDWrite *wr = obc.prepare_write(snapc, wbl,
+						       ceph::real_time::min(), 0,
+						       ++journal_tid);
+	wr->extents.push_back(op.extent);
+	lock.lock();
+	obc.writex(wr, sets[f].get(), NULL);
+	lock.unlock();
+	bytes_written += length;
+      }
+    }
+  };
+
+  auto start = ceph::mono_clock::now();
+  std::vector<std::thread> threads;
+  for (uint64_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back(worker, t);
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  C_SaferCond flushcond;
+  lock.lock();
+  bool done = obc.flush_all(&flushcond);
+  lock.unlock();
+  if (!done) {
+    flushcond.wait();
+  }
+  double elapsed = std::chrono::duration<double>(
+    ceph::mono_clock::now() - start).count();
+
+  bool unclean = false;
+  lock.lock();
+  for (auto& oset : sets) {
+    unclean |= obc.release_set(oset.get());
+  }
+  lock.unlock();
+  obc.stop();
+
+  if (unclean) {
+    std::cout << "unclean buffers left over!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  uint64_t total_ops = num_threads * ops_per_thread;
+  std::cout << "elapsed: " << elapsed << " s\n"
+	    << "ops/s: " << total_ops / elapsed << "\n"
+	    << "read MB/s: " << bytes_read / elapsed / (1 << 20) << "\n"
+	    << "write MB/s: " << bytes_written / elapsed / (1 << 20)
+	    << std::endl;
+  return EXIT_SUCCESS;
+}
+
 int correctness_test(uint64_t delay_ns)
 {
   std::cerr << "starting correctness test" << std::endl;
@@ -363,10 +480,13 @@ int main(int argc, const char **argv)
   long long obj_bytes = 4 << 20;
   long long max_len = 128 << 10;
   long long num_objs = 10;
+  long long num_threads = 8;
+  long long num_files = 64;
   float percent_reads = 0.90;
   int seed = time(0) % 100000;
   bool stress = false;
   bool correctness = false;
+  bool throughput = false;
   std::ostringstream err;
   std::vector<const char*>::iterator i;
   for (i = args.begin(); i != args.end();) {
@@ -400,6 +520,16 @@ int main(int argc, const char **argv)
 	cerr << argv[0] << ": " << err.str() << std::endl;
 	return EXIT_FAILURE;
       }
+    } else if (ceph_argparse_witharg(args, i, &num_threads, err, "--threads", (char*)NULL)) {
+      if (!err.str().empty()) {
+	cerr << argv[0] << ": " << err.str() << std::endl;
+	return EXIT_FAILURE;
+      }
+    } else if (ceph_argparse_witharg(args, i, &num_files, err, "--files", (char*)NULL)) {
+      if (!err.str().empty()) {
+	cerr << argv[0] << ": " << err.str() << std::endl;
+	return EXIT_FAILURE;
+      }
     } else if (ceph_argparse_witharg(args, i, &seed, err, "--seed", (char*)NULL)) {
       if (!err.str().empty()) {
 	cerr << argv[0] << ": " << err.str() << std::endl;
@@ -409,6 +539,8 @@ int main(int argc, const char **argv)
       stress = true;
     } else if (ceph_argparse_flag(args, i, "--correctness-test", NULL)) {
       correctness = true;
+    } else if (ceph_argparse_flag(args, i, "--throughput-test", NULL)) {
+      throughput = true;
     } else {
       cerr << "unknown option " << *i << std::endl;
       return EXIT_FAILURE;
@@ -422,4 +554,8 @@ int main(int argc, const char **argv)
   if (correctness) {
     return correctness_test(delay_ns);
   }
+  if (throughput) {
+    return throughput_test(num_threads, num_files, num_ops, obj_bytes,
+			   delay_ns, max_len, percent_reads);
+  }
 }
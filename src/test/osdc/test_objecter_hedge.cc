@@ -0,0 +1,46 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include "gtest/gtest.h"
+
+#include "osdc/Objecter.h"
+
+static osdc_opvec make_ops(std::initializer_list<int> codes)
+{
+  osdc_opvec ops;
+  for (auto c : codes) {
+    ops.emplace_back();
+    ops.back().op.op = c;
+  }
+  return ops;
+}
+
+TEST(ObjecterHedge, PlainReads) {
+  EXPECT_TRUE(Objecter::is_hedgeable_read(make_ops({CEPH_OSD_OP_READ})));
+  EXPECT_TRUE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_STAT, CEPH_OSD_OP_SPARSE_READ})));
+  EXPECT_TRUE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_ASSERT_VER, CEPH_OSD_OP_READ,
+	      CEPH_OSD_OP_GETXATTRS})));
+  EXPECT_TRUE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_OMAPGETHEADER, CEPH_OSD_OP_OMAPGETVALS})));
+  EXPECT_TRUE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_CMPEXT, CEPH_OSD_OP_CHECKSUM})));
+}
+
+TEST(ObjecterHedge, NotPlainReads) {
+  EXPECT_FALSE(Objecter::is_hedgeable_read(make_ops({})));
+  EXPECT_FALSE(Objecter::is_hedgeable_read(make_ops({CEPH_OSD_OP_WATCH})));
+  EXPECT_FALSE(Objecter::is_hedgeable_read(make_ops({CEPH_OSD_OP_NOTIFY})));
+  EXPECT_FALSE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_NOTIFY_ACK})));
+  EXPECT_FALSE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_LIST_WATCHERS})));
+  // class methods may have side effects even when flagged as reads
+  EXPECT_FALSE(Objecter::is_hedgeable_read(make_ops({CEPH_OSD_OP_CALL})));
+  // one non-read op taints the whole vector
+  EXPECT_FALSE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_READ, CEPH_OSD_OP_CALL})));
+  EXPECT_FALSE(Objecter::is_hedgeable_read(
+    make_ops({CEPH_OSD_OP_READ, CEPH_OSD_OP_WRITE})));
+}